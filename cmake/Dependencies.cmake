@@ -12,7 +12,10 @@ FetchContent_Declare(ftxui
 set(BOX2D_SAMPLES OFF CACHE BOOL "" FORCE)
 set(BOX2D_BENCHMARKS OFF CACHE BOOL "" FORCE)
 set(BOX2D_DOCS OFF CACHE BOOL "" FORCE)
-set(BOX2D_PROFILE OFF CACHE BOOL "" FORCE)
+# Stage timings (b2World_GetProfile) are always collected; this only adds
+# Box2D's Tracy zones
+option(ENABLE_BOX2D_PROFILE "Build Box2D with its Tracy profiling zones" OFF)
+set(BOX2D_PROFILE ${ENABLE_BOX2D_PROFILE} CACHE BOOL "" FORCE)
 set(BOX2D_VALIDATE OFF CACHE BOOL "" FORCE)
 set(BOX2D_UNIT_TESTS OFF CACHE BOOL "" FORCE)
 FetchContent_Declare(box2d
@@ -1,14 +1,17 @@
 #include "app.hpp"
 #include "config.hpp"
+#include "diagnostics/memory_tags.hpp"
+#include "diagnostics/profiler.hpp"
+#include "diagnostics/trace.hpp"
 #include "input/kitty_keyboard.hpp"
 
 #include <ftxui/component/loop.hpp>
 #include <ftxui/dom/elements.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <csignal>
 #include <cstdlib>
-#include <thread>
 #include <unistd.h>
 
 // Global flag for atexit/signal cleanup of kitty protocol
@@ -39,9 +42,12 @@ App::App(std::unique_ptr<StdinReader> stdin_reader)
 
     input_manager_ = std::make_unique<InputManager>();
     game_session_ = std::make_unique<GameSession>(*stdin_reader_);
-    renderer_ = std::make_unique<Renderer>();
-    mask_renderer_ = std::make_unique<MaskRenderer>(std::string(MASQUERADE_ASSETS_DIR) + "/mask.png");
+    renderer_ = std::make_unique<Renderer>(std::string(MASQUERADE_ASSETS_DIR) + "/mask.png");
     hud_ = std::make_unique<HUD>();
+    text_bar_ = std::make_unique<TextBar>();
+
+    // Route FTXUI's output through the diffing presenter
+    presenter_ = std::make_unique<TerminalPresenter>(screen_);
 
     // Enable stdin
     screen_.HandlePipedInput(true);
@@ -57,23 +63,70 @@ App::App(std::unique_ptr<StdinReader> stdin_reader)
 
 App::~App() {
     disableKittyProtocol();
+    latency_.dump();
+    memory::logSnapshot();
 }
 
 void App::run() {
+    using Clock = std::chrono::steady_clock;
+
     auto ui = buildUI();
     ftxui::Loop loop(&screen_, ui);
 
-    auto last_time = std::chrono::steady_clock::now();
-    constexpr auto frame_duration = std::chrono::milliseconds(1000 / 60);
+    // Read the terminal on a thread of its own once FTXUI has set it up;
+    // without a TTY, input keeps arriving through FTXUI alone
+    input_thread_.start();
+
+    // Sleep on whatever fd 0 is now (the input thread's pipe or the TTY).
+    // Input that can't be polled means ticking every frame, as before
+    const bool input_watched = reactor_.watchInput(STDIN_FILENO);
+    renderer_->setFrameReadyCallback([this] { reactor_.wake(); });
+
+    auto last_step = Clock::now();
+    bool stepping = false;          // Last tick stepped the game
+    Clock::time_point settle_until; // Keep ticking until then after input
+    uint32_t ready = Reactor::WAKE; // Draw the first frame
+    auto next_memory_log = last_step + MEMORY_LOG_INTERVAL;
 
     while (!loop.HasQuitted()) {
-        auto now = std::chrono::steady_clock::now();
-        float dt = std::chrono::duration<float>(now - last_time).count();
-        last_time = now;
+        auto now = Clock::now();
+        if (ready & (Reactor::INPUT | Reactor::SIGNAL)) {
+            settle_until = now + INPUT_SETTLE;
+        }
+        if (ready & Reactor::WAKE) {
+            // The render thread finished a frame: show it
+            screen_.RequestAnimationFrame();
+        }
+
+        const uint64_t frames_before = presenter_->stats().frames;
+        const auto ui_start = Clock::now();
+        {
+            MEMORY_SCOPE(Ftxui);
+            presenter_->beginFrame();
+            loop.RunOnce();
+            presenter_->endFrame();
+        }
+        if (presenter_->stats().frames != frames_before) {
+            // FTXUI drew a frame: split its time between layout and output
+            const auto ui_end = Clock::now();
+            const auto write_start = ui_end - presenter_->stats().write_time;
+            Profiler::instance().record(ProfileZone::Layout, ui_start, write_start);
+            Profiler::instance().record(ProfileZone::TerminalWrite, write_start, ui_end);
+        }
+        latency_.frameWritten(presenter_->stats().written_tag, presenter_->stats().written_at);
 
-        input_manager_->beginFrame();
-        loop.RunOnce();
-        input_manager_->endFrame();
+        if (now >= next_memory_log) {
+            memory::logSnapshot();
+            next_memory_log = now + MEMORY_LOG_INTERVAL;
+        }
+
+        // Adapt quality to how fast the terminal drains our output
+        governor_.update(presenter_->stats(), now);
+        if (current_state_ == GameState::Playing && governor_.takeProbe(now)) {
+            presenter_->queue(QualityGovernor::PROBE);
+        }
+        renderer_->setMaskColor(governor_.maskColor());
+        renderer_->setHalfResTerrain(governor_.halfResTerrain());
 
         // Sync kitty_active_ with InputManager's auto-detection.
         // If the InputManager disabled kitty mode (unsupported terminal),
@@ -84,12 +137,39 @@ void App::run() {
             kitty::disable();
         }
 
-        if (current_state_ == GameState::Playing) {
+        input_thread_.setCapture(kitty_active_ && current_state_ == GameState::Playing);
+        drainKeyEvents();
+
+        // The game steps on timer ticks only; other wakes just handle input
+        // and show frames
+        const bool step = current_state_ == GameState::Playing && (ready & Reactor::TIMER);
+        if (step) {
+            // Time since the previous step, or one frame when play resumes
+            float dt = std::chrono::duration<float>(
+                stepping ? now - last_step : governor_.frameInterval()).count();
+            last_step = now;
+
+            // Sample input right before the step, with game keys stamped by
+            // the input thread at the time they were read
+            {
+                PROFILE_SCOPE(Input);
+                input_manager_->endFrame();
+            }
+
             // Update game
             game_session_->update(dt, input_manager_->snapshot());
 
-            // Update camera to track ball
-            renderer_->camera().update(game_session_->ball().getCenterPosition(), dt);
+            // Update camera to track ball, zooming out with speed so the
+            // terrain ahead comes into view
+            auto& camera = renderer_->camera();
+            const auto& ball = game_session_->ball();
+            float overspeed = std::max(0.0f, ball.getSpeed() - SPEED_ZOOM_START);
+            camera.setZoom(zoom_ / (1.0f + overspeed * SPEED_ZOOM_RATE));
+            camera.update(ball.getCenterPosition(), dt);
+            game_session_->setLookAhead(camera.viewportRight() - ball.getCenterPosition().x);
+
+            // Input from here on belongs to the next step
+            input_manager_->beginFrame();
 
             // Check for game state transitions
             if (game_session_->isGameOver()) {
@@ -98,15 +178,74 @@ void App::run() {
                 transitionTo(GameState::LevelComplete);
             }
         }
+        stepping = step || (stepping && current_state_ == GameState::Playing);
+
+        // Hand the frame to the render thread while the world is visible;
+        // it rasterizes while this thread sleeps and wakes it when done.
+        // Under a modal the world only changes on input (restart) or resize
+        const bool submit = tab_index_ == 2 &&
+            (step || (current_state_ != GameState::Playing &&
+                      (ready & (Reactor::INPUT | Reactor::SIGNAL))));
+        if (submit) {
+            renderer_->setCellEncoding(cell_encoding_);
+            renderer_->setTerrainFill(terrain_fill_);
+            renderer_->setBackground(background_enabled_);
+            uint64_t frame_id = renderer_->submitFrame(*game_session_, debug_enabled_,
+                                                       screen_.dimx(), screen_.dimy());
+            if (auto stamp = game_session_->takeAppliedInput()) {
+                latency_.inputApplied(frame_id, *stamp);
+            }
+            TRACE_INSTANT("frame", static_cast<int64_t>(frame_id));
+        }
+        if (step) {
+            Profiler::instance().record(ProfileZone::Frame, now, Clock::now());
+        }
 
-        screen_.RequestAnimationFrame();
-        std::this_thread::sleep_until(now + frame_duration);
+        // Tick while playing, while a frame is still draining to a slow
+        // terminal, and briefly after input so FTXUI can time out a lone
+        // Escape. Otherwise sleep until something happens.
+        if (current_state_ == GameState::Playing || presenter_->draining() ||
+            now < settle_until || !input_watched) {
+            reactor_.armFrameTimer(governor_.frameInterval());
+        } else {
+            reactor_.disarmFrameTimer();
+        }
+        ready = reactor_.wait();
     }
 
+    // Give the terminal back before FTXUI restores it
+    input_thread_.stop();
+
     // Ensure kitty protocol is disabled before exiting
     disableKittyProtocol();
 }
 
+void App::drainKeyEvents() {
+    TimedKeyEvent event;
+    while (input_thread_.events().pop(event)) {
+        routeKeyEvent(event);
+    }
+}
+
+void App::routeKeyEvent(const TimedKeyEvent& event) {
+    // Keys after a pause in the same batch are no longer meant for the game
+    if (current_state_ != GameState::Playing) {
+        return;
+    }
+
+    // Game controls
+    input_manager_->handleKeyEvent(event);
+
+    // Escape pauses, zoom keys zoom (only on press)
+    if (event.key.event_type == kitty::EventType::Press) {
+        if (kitty::toGameKey(event.key.keycode) == kitty::GameKey::Escape) {
+            transitionTo(GameState::Paused);
+        } else {
+            handleZoomKey(event.key.keycode);
+        }
+    }
+}
+
 ftxui::Component App::buildUI() {
     using namespace ftxui;
 
@@ -118,7 +257,8 @@ ftxui::Component App::buildUI() {
     };
 
     start_menu_ = std::make_unique<StartMenu>(transition);
-    options_menu_ = std::make_unique<OptionsMenu>(transition, &debug_enabled_);
+    options_menu_ = std::make_unique<OptionsMenu>(transition, &debug_enabled_, &cell_encoding_,
+                                                  &terrain_fill_, &background_enabled_);
     pause_menu_ = std::make_unique<PauseMenu>(transition, restart);
     game_over_overlay_ = std::make_unique<GameOverOverlay>(transition, restart);
     level_complete_overlay_ = std::make_unique<LevelCompleteOverlay>(transition);
@@ -156,25 +296,20 @@ ftxui::Component App::buildUI() {
 
     // Wrap with global event handlers
     return CatchEvent(tab, [this](ftxui::Event event) {
+        // Round-trip probe replies are for the quality governor only
+        if (governor_.handleInput(event.input(), std::chrono::steady_clock::now())) {
+            return true;
+        }
+
         // When kitty protocol is active during gameplay, parse events through the kitty parser
         if (kitty_active_ && current_state_ == GameState::Playing) {
 
-            // Try to parse as kitty sequence for game input
-            auto kitty_event = kitty::parse(event.input());
-            if (kitty_event) {
-                // Route to input manager for game controls
-                input_manager_->handleRawEvent(event);
-
-                // Handle escape key for pause (only on press)
-                if (kitty_event->event_type == kitty::EventType::Press) {
-                    auto game_key = kitty::toGameKey(kitty_event->keycode);
-
-                    if (game_key == kitty::GameKey::Escape) {
-                        transitionTo(GameState::Paused);
-                        return true;
-                    }
-                }
-
+            // Parse once; the event may carry several sequences
+            auto now = std::chrono::steady_clock::now();
+            int keys = kitty::forEachKey(event.input(), [&](const kitty::KeyEvent& key) {
+                routeKeyEvent({key, now});
+            });
+            if (keys > 0) {
                 return true;  // Consume all kitty events during gameplay
             }
 
@@ -186,6 +321,10 @@ ftxui::Component App::buildUI() {
 
         // Non-kitty mode: pass events to input manager when in game
         if (current_state_ == GameState::Playing) {
+            if (event.is_character() && event.character().size() == 1 &&
+                handleZoomKey(static_cast<unsigned char>(event.character()[0]))) {
+                return true;
+            }
             input_manager_->handleFtxuiEvent(event);
         }
 
@@ -214,60 +353,50 @@ ftxui::Component App::buildUI() {
     });
 }
 
+bool App::handleZoomKey(uint32_t codepoint) {
+    if (codepoint == '-') {
+        zoom_ = std::max(zoom_ / ZOOM_STEP, Camera::MIN_ZOOM);
+    } else if (codepoint == '=' || codepoint == '+') {
+        zoom_ = std::min(zoom_ * ZOOM_STEP, Camera::MAX_ZOOM);
+    } else if (codepoint == '0') {
+        zoom_ = 1.0f;
+    } else {
+        return false;
+    }
+    return true;
+}
+
 ftxui::Component App::buildGameComponent() {
     using namespace ftxui;
 
     return ftxui::Renderer([this] {
-        // Get terminal dimensions
-        int screen_width = screen_.dimx() * 2;   // Braille: 2 pixels per column
-        int screen_height = screen_.dimy() * 4;  // Braille: 4 pixels per row
-
-        // Render game world with both terrain and ball (DEBUG MODE)
-        auto game_canvas = canvas(screen_width / 2, screen_height / 2, [this, screen_width, screen_height](Canvas& c) {
-            auto& camera = renderer_->camera();
-
-            // Update camera screen size in braille pixels for proper centering
-            camera.setScreenSize(screen_width, screen_height);
-
-            // Draw terrain
-            TerrainRenderer terrain_renderer;
-            terrain_renderer.draw(c, camera, game_session_->segments());
-
-            // Draw ball
-            BallRenderer ball_renderer;
-            if (debug_enabled_) {
-                ball_renderer.drawDebug(c, camera,
-                                       game_session_->ball().getCenterPosition(),
-                                       game_session_->ball().getRimPositions(),
-                                       SoftbodyBall::CORE_RADIUS,
-                                       SoftbodyBall::RIM_CIRCLE_RADIUS);
-            } else {
-                ball_renderer.draw(c, camera,
-                                  game_session_->ball().getCenterPosition(),
-                                  game_session_->ball().getRimPositions());
-            }
-
-            // Draw mask overlay
-            mask_renderer_->draw(c, camera,
-                                 game_session_->mask().getPosition());
-        });
+        // Newest frame finished by the render thread
+        auto game_canvas = renderer_->gameCanvas();
+        presenter_->tagFrame(renderer_->shownFrameId());
+        auto& camera = renderer_->camera();
 
         // Build UI layers
         auto hud_element = hud_->render(game_session_->score(),
                                         game_session_->speedMultiplier(),
                                         debug_enabled_,
-                                        input_manager_->snapshot());
-
-        // Build text bar overlay at bottom third of screen
-        auto& camera = renderer_->camera();
-        TextBar text_bar;
-        auto text_bar_element = text_bar.render(
-            game_session_->segments(),
-            camera.viewportLeft(),
-            camera.viewportRight(),
-            screen_.dimx(),
-            screen_width  // Pass braille pixel width for proper scaling
-        );
+                                        input_manager_->snapshot(),
+                                        presenter_->stats(),
+                                        governor_,
+                                        game_session_->particles().stats(),
+                                        latency_,
+                                        Profiler::instance());
+
+        // Build text bar overlay at bottom third of screen (dropped first
+        // when the terminal can't keep up)
+        Element text_bar_element = emptyElement();
+        if (governor_.showTextBar()) {
+            PROFILE_SCOPE(TextBar);
+            text_bar_element = text_bar_->render(
+                game_session_->segments(),
+                camera.viewportLeft(),
+                camera.viewportRight(),
+                screen_.dimx());
+        }
 
         auto game_view = vbox({
             hud_element,
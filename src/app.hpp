@@ -1,6 +1,7 @@
 #pragma once
 
 #include "game_state.hpp"
+#include "diagnostics/latency_tracker.hpp"
 #include "ui/start_menu.hpp"
 #include "ui/options_menu.hpp"
 #include "ui/pause_menu.hpp"
@@ -9,16 +10,19 @@
 #include "ui/level_complete_overlay.hpp"
 #include "ui/text_bar.hpp"
 #include "input/input_manager.hpp"
+#include "input/input_thread.hpp"
 #include "game/game_session.hpp"
 #include "rendering/renderer.hpp"
-#include "rendering/terrain_renderer.hpp"
-#include "rendering/ball_renderer.hpp"
-#include "rendering/mask_renderer.hpp"
 #include "level/stdin_reader.hpp"
+#include "terminal/terminal_presenter.hpp"
+#include "terminal/quality_governor.hpp"
+#include "terminal/reactor.hpp"
 
 #include <ftxui/component/component.hpp>
 #include <ftxui/component/screen_interactive.hpp>
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 
 class App {
@@ -32,6 +36,10 @@ private:
     GameState current_state_ = GameState::StartMenu;
     int tab_index_ = 0;
     bool debug_enabled_ = false;
+    CellEncoding cell_encoding_ = CellEncoding::Braille;
+    TerrainFill terrain_fill_ = TerrainFill::Outline;
+    bool background_enabled_ = true;
+    float zoom_ = 1.0f; // Player-chosen zoom before speed zoom-out
     bool kitty_active_ = false;
 
     // Modal visibility flags (pointed to by FTXUI Modal components)
@@ -40,21 +48,43 @@ private:
     bool show_level_complete_modal_ = false;
 
     std::unique_ptr<StdinReader> stdin_reader_;
+    std::unique_ptr<TerminalPresenter> presenter_;
+    QualityGovernor governor_;
+    LatencyTracker latency_;
+    Reactor reactor_; // Outlives renderer_, whose thread wakes it
     std::unique_ptr<StartMenu> start_menu_;
     std::unique_ptr<OptionsMenu> options_menu_;
     std::unique_ptr<PauseMenu> pause_menu_;
     std::unique_ptr<InputManager> input_manager_;
+    InputThread input_thread_;
     std::unique_ptr<GameSession> game_session_;
     std::unique_ptr<Renderer> renderer_;
-    std::unique_ptr<MaskRenderer> mask_renderer_;
     std::unique_ptr<HUD> hud_;
+    std::unique_ptr<TextBar> text_bar_;
     std::unique_ptr<GameOverOverlay> game_over_overlay_;
     std::unique_ptr<LevelCompleteOverlay> level_complete_overlay_;
 
+    // Zoom keys while playing: '-' out, '=' / '+' in, '0' reset
+    static constexpr float ZOOM_STEP = 1.25f;
+    static constexpr float SPEED_ZOOM_START = 6.0f; // m/s before zooming out
+    static constexpr float SPEED_ZOOM_RATE = 0.05f; // Zoom-out per m/s beyond that
+
+    // Ticks kept running after input outside gameplay (FTXUI resolves a
+    // lone Escape by timeout)
+    static constexpr auto INPUT_SETTLE = std::chrono::milliseconds(100);
+    // Per-subsystem memory to the debug log (also once on exit)
+    static constexpr auto MEMORY_LOG_INTERVAL = std::chrono::seconds(10);
+    bool handleZoomKey(uint32_t codepoint);
+
     ftxui::Component buildUI();
     ftxui::Component buildGameComponent();
     void transitionTo(GameState new_state);
 
+    // Apply key events the input thread claimed since the last step
+    void drainKeyEvents();
+    // Send one kitty key to the input manager and the pause/zoom keys
+    void routeKeyEvent(const TimedKeyEvent& event);
+
     // Enable/disable the kitty keyboard protocol for game input
     void enableKittyProtocol();
     void disableKittyProtocol();
@@ -0,0 +1,124 @@
+#include "bench/alloc_check.hpp"
+#include "config.hpp"
+#include "diagnostics/alloc_counter.hpp"
+#include "diagnostics/memory_tags.hpp"
+#include "game/game_session.hpp"
+#include "level/stdin_reader.hpp"
+#include "rendering/renderer.hpp"
+#include "terminal/frame_encoder.hpp"
+#include "ui/hud.hpp"
+#include "ui/text_bar.hpp"
+
+#include <ftxui/dom/node.hpp>
+#include <ftxui/screen/screen.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+namespace {
+
+constexpr int WARM_UP_FRAMES = 120;
+constexpr float DT = 1.0f / 60.0f;
+
+// Blocks allocated so far for new terrain
+uint64_t generationBlocks() {
+    return memory::stats(MemoryTag::Segments).total_blocks +
+           memory::stats(MemoryTag::Box2D).total_blocks;
+}
+
+} // namespace
+
+int runAllocCheck(int cols, int rows, int frames) {
+    // Let the reader thread finish so only the frame path allocates
+    StdinReader stdin_reader;
+    stdin_reader.start();
+    while (!stdin_reader.isEof()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    GameSession session(stdin_reader);
+    Renderer renderer(std::string(MASQUERADE_ASSETS_DIR) + "/mask.png");
+    renderer.camera().update(session.ball().getCenterPosition(), 1.0f);
+    ftxui::Screen screen(cols, rows);
+    FrameEncoder encoder;
+    std::string out;
+
+    HUD hud;
+    TextBar text_bar;
+
+    InputSnapshot input;
+    input.move_right = true;
+
+    int measured = 0;
+    int generating = 0;
+    int allocating = 0;
+    uint64_t frame_allocations = 0;
+    uint64_t ui_allocations = 0;
+    uint64_t encode_allocations = 0;
+
+    for (int frame = 0; frame < WARM_UP_FRAMES + frames; ++frame) {
+        if (session.isGameOver() || session.isLevelComplete()) {
+            break;
+        }
+        size_t segment_count = session.segments().size();
+
+        // Simulation, snapshot, record and rasterize. New terrain
+        // legitimately allocates (segment, Box2D chain); that is charged to
+        // its memory tags and taken out, and anything else still counts.
+        uint64_t before = heapAllocationCount();
+        uint64_t generation_before = generationBlocks();
+        session.update(DT, input);
+        renderer.camera().update(session.ball().getCenterPosition(), DT);
+        renderer.submitFrame(session, false, cols, rows);
+        renderer.waitIdle();
+        uint64_t simulated = heapAllocationCount() - before -
+                             (generationBlocks() - generation_before);
+
+        // Our side of the HUD and text bar: the buffers their elements show
+        const Camera& camera = renderer.camera();
+        uint64_t ui_before = heapAllocationCount();
+        hud.formatScoreLine(session.score(), session.speedMultiplier());
+        text_bar.layout(session.segments(), camera.viewportLeft(), camera.viewportRight(), cols);
+        uint64_t ui = heapAllocationCount() - ui_before;
+
+        // FTXUI builds and lays out its element tree; not ours to count
+        screen.Clear();
+        ftxui::Render(screen, renderer.gameCanvas());
+
+        uint64_t encode_before = heapAllocationCount();
+        out.clear();
+        encoder.encode(screen, out);
+        uint64_t encoded = heapAllocationCount() - encode_before;
+
+        if (frame < WARM_UP_FRAMES) {
+            continue;
+        }
+        measured++;
+        if (session.segments().size() != segment_count) {
+            generating++;
+        }
+
+        uint64_t count = simulated + ui + encoded;
+        if (count > 0) {
+            allocating++;
+            frame_allocations += simulated;
+            ui_allocations += ui;
+            encode_allocations += encoded;
+            std::printf("  frame %d: %llu allocations (%llu in HUD/text bar, %llu in encode)\n",
+                        frame, static_cast<unsigned long long>(count),
+                        static_cast<unsigned long long>(ui),
+                        static_cast<unsigned long long>(encoded));
+        }
+    }
+
+    std::printf("alloc check: %dx%d cells, %d steady-state frames, %d generated terrain\n",
+                cols, rows, measured, generating);
+    std::printf("  %d frames allocated: %llu in update/render, %llu in HUD/text bar, "
+                "%llu in encode\n", allocating,
+                static_cast<unsigned long long>(frame_allocations),
+                static_cast<unsigned long long>(ui_allocations),
+                static_cast<unsigned long long>(encode_allocations));
+    return allocating == 0 ? 0 : 1;
+}
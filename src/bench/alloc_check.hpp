@@ -0,0 +1,8 @@
+#pragma once
+
+// Play the level headlessly (ball rolling right, frames rendered, HUD and
+// text bar composed, frames encoded at cols x rows) and count heap
+// allocations per steady-state frame after a warm-up. Returns nonzero if
+// any frame allocated outside terrain generation (charged to the Segments
+// and Box2D memory tags) and FTXUI's element tree.
+int runAllocCheck(int cols, int rows, int frames);
@@ -0,0 +1,54 @@
+#include "bench/bench_scene.hpp"
+
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+void buildBenchScene(DrawList& list, PixelSprite& mask, int width, int height, int frame) {
+    // Doubled terrain outline across the whole view, ~0.25 m per sample
+    constexpr int step = 7;
+    auto terrain_y = [&](int x) {
+        float world_x = static_cast<float>(x + frame * 2);
+        return static_cast<int>(height * 0.6f + std::sin(world_x * 0.03f) * height * 0.15f);
+    };
+    for (int x = 0; x + step < width; x += step) {
+        int y0 = terrain_y(x), y1 = terrain_y(x + step);
+        list.line(x, y0, x + step, y1);
+        list.line(x, y0 + 1, x + step, y1 + 1);
+    }
+
+    // Twelve-wedge ball in the middle of the view
+    constexpr int rim_count = 12;
+    int cx = width / 2, cy = height / 2;
+    int radius = 15;
+    float spin = frame * 0.1f;
+    std::vector<DrawList::Edge> edges;
+    for (int i = 0; i < rim_count; i += 2) {
+        auto rim = [&](int k) {
+            float angle = 2.0f * static_cast<float>(M_PI) * k / rim_count - spin;
+            return std::pair<int, int>{cx + static_cast<int>(radius * std::cos(angle)),
+                                       cy - static_cast<int>(radius * std::sin(angle))};
+        };
+        auto [ax, ay] = rim(i);
+        auto [bx, by] = rim(i + 1);
+        edges.push_back({cx, cy, ax, ay});
+        edges.push_back({ax, ay, bx, by});
+        edges.push_back({bx, by, cx, cy});
+        list.line(cx, cy, ax, ay);
+        list.line(ax, ay, bx, by);
+    }
+    list.evenOddFill(edges.data(), static_cast<int>(edges.size()));
+
+    // Mask-sized sprite with a random opaque pattern
+    std::mt19937 rng(7);
+    mask.resize(36, 30);
+    for (int y = 0; y < mask.height; ++y) {
+        for (int x = 0; x < mask.width; ++x) {
+            if (rng() % 3 != 0) {
+                mask.set(x, y);
+            }
+        }
+    }
+    list.sprite(mask, cx - 28, cy - 30, Ink::Mask);
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "rendering/draw_list.hpp"
+#include "rendering/pixel_canvas.hpp"
+
+// Record a synthetic game frame into the list: doubled terrain outline
+// across the view, a twelve-wedge ball in the middle and a mask-sized
+// sprite. frame scrolls the terrain and spins the ball, the way the camera
+// follows a rolling ball. The mask sprite is (re)generated into mask.
+void buildBenchScene(DrawList& list, PixelSprite& mask, int width, int height, int frame = 0);
@@ -0,0 +1,230 @@
+#include "bench/kitty_bench.hpp"
+#include "diagnostics/alloc_counter.hpp"
+#include "input/kitty_keyboard.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t SEED = 0xC5140042u;
+constexpr int THROUGHPUT_PASSES = 5;
+constexpr size_t FUZZ_BYTES = 1 << 20;
+constexpr size_t MAX_READ = 64; // Largest random read when splitting
+
+struct Stream {
+    std::string bytes;
+    std::vector<kitty::KeyEvent> keys; // Every key sequence written, in order
+};
+
+bool sameKey(const kitty::KeyEvent& a, const kitty::KeyEvent& b) {
+    return a.keycode == b.keycode && a.modifiers == b.modifiers &&
+           a.event_type == b.event_type;
+}
+
+void appendKey(Stream& stream, std::mt19937& rng) {
+    static const uint32_t GAME_KEYS[] = {32, 13, 27, 97, 57417, 57419, 57420, 57421};
+    static const char FUNCTIONAL[] = {'A', 'B', 'C', 'D', 'F', 'H', 'P', 'Q', 'R', 'S'};
+    static const uint32_t FUNCTIONAL_CODES[] = {57417, 57420, 57421, 57419, 57424,
+                                                57423, 57364, 57365, 57366, 57367};
+
+    kitty::KeyEvent key{};
+    key.modifiers = static_cast<uint8_t>(rng() % 4 == 0 ? rng() % 256 : 0);
+    key.event_type = static_cast<kitty::EventType>(1 + rng() % 3);
+    bool explicit_type = key.event_type != kitty::EventType::Press || rng() % 2 == 0;
+
+    std::string& out = stream.bytes;
+    out += "\x1b[";
+    char terminator = 'u';
+    if (rng() % 3 == 0) {
+        // Functional form: CSI 1 ; modifiers[:type] X
+        int which = static_cast<int>(rng() % 10);
+        terminator = FUNCTIONAL[which];
+        key.keycode = FUNCTIONAL_CODES[which];
+        out += '1';
+    } else {
+        key.keycode = rng() % 2 == 0 ? GAME_KEYS[rng() % 8] : rng() % 0x110000;
+        out += std::to_string(key.keycode);
+        if (rng() % 8 == 0) {
+            out += ":" + std::to_string(rng() % 0x110000); // Shifted key
+        }
+    }
+
+    bool has_modifiers = key.modifiers != 0 || explicit_type || rng() % 4 == 0;
+    if (has_modifiers) {
+        out += ";" + std::to_string(key.modifiers + 1);
+        if (explicit_type) {
+            out += ":" + std::to_string(static_cast<int>(key.event_type));
+        }
+        if (terminator == 'u' && rng() % 6 == 0) {
+            out += ";" + std::to_string(32 + rng() % 95); // Text codepoints
+        }
+    } else {
+        key.event_type = kitty::EventType::Press;
+    }
+    out += terminator;
+    stream.keys.push_back(key);
+}
+
+void appendOther(Stream& stream, std::mt19937& rng) {
+    static const char* const OTHER[] = {
+        "\x1b[?1;2c",        // Device attributes
+        "\x1b[38;5;208m",    // SGR
+        "\x1b[?62;22c",
+        "\x1b[?1u",          // Kitty flags reply
+        "\x1b[200~",         // Bracketed paste start
+        "\x1bOP",            // SS3, not CSI
+    };
+    stream.bytes += OTHER[rng() % 6];
+}
+
+void appendText(Stream& stream, std::mt19937& rng) {
+    int length = 1 + static_cast<int>(rng() % 12);
+    for (int i = 0; i < length; ++i) {
+        stream.bytes += static_cast<char>(' ' + rng() % 95);
+    }
+}
+
+Stream buildStream(size_t bytes, std::mt19937& rng) {
+    Stream stream;
+    stream.bytes.reserve(bytes + 64);
+    while (stream.bytes.size() < bytes) {
+        switch (rng() % 8) {
+            case 0: appendOther(stream, rng); break;
+            case 1: appendText(stream, rng); break;
+            default: appendKey(stream, rng); break;
+        }
+    }
+    return stream;
+}
+
+// Keys found scanning the stream as a series of random reads, carrying an
+// incomplete sequence over like InputThread does
+void scanInReads(const std::string& bytes, std::mt19937& rng,
+                 std::vector<kitty::KeyEvent>& found) {
+    std::string pending;
+    size_t offset = 0;
+    while (offset < bytes.size()) {
+        size_t length = std::min<size_t>(1 + rng() % MAX_READ, bytes.size() - offset);
+        pending.append(bytes, offset, length);
+        offset += length;
+
+        std::string_view view(pending);
+        while (!view.empty()) {
+            kitty::Scan scanned = kitty::scan(view);
+            if (scanned.kind == kitty::Scan::Kind::Incomplete) {
+                break;
+            }
+            if (scanned.kind == kitty::Scan::Kind::Key) {
+                found.push_back(scanned.event);
+            }
+            view.remove_prefix(scanned.length);
+        }
+        pending.erase(0, pending.size() - view.size());
+    }
+}
+
+int checkKeys(const char* label, const std::vector<kitty::KeyEvent>& expected,
+              const std::vector<kitty::KeyEvent>& found) {
+    size_t mismatches = expected.size() > found.size() ? expected.size() - found.size()
+                                                       : found.size() - expected.size();
+    size_t first_bad = SIZE_MAX;
+    for (size_t i = 0; i < std::min(expected.size(), found.size()); ++i) {
+        if (!sameKey(expected[i], found[i])) {
+            mismatches++;
+            first_bad = std::min(first_bad, i);
+        }
+    }
+    std::printf("  %-22s %zu keys, %zu mismatches", label, found.size(), mismatches);
+    if (first_bad != SIZE_MAX) {
+        std::printf(" (first at key %zu)", first_bad);
+    }
+    std::printf("\n");
+    return mismatches == 0 ? 0 : 1;
+}
+
+// Random bytes, heavy on ESC and CSI characters; every scan must make
+// progress and stay inside the buffer
+int fuzzRandomBytes(std::mt19937& rng) {
+    static const char ALPHABET[] = "\x1b[;:0123456789uABCDHPRS?~\x7f\x01 a";
+    std::string bytes(FUZZ_BYTES, '\0');
+    for (auto& c : bytes) {
+        c = rng() % 4 == 0 ? static_cast<char>(rng()) : ALPHABET[rng() % (sizeof(ALPHABET) - 1)];
+    }
+
+    size_t bad = 0;
+    size_t scans = 0;
+    std::string_view view(bytes);
+    while (!view.empty()) {
+        kitty::Scan scanned = kitty::scan(view);
+        scans++;
+        if (scanned.kind == kitty::Scan::Kind::Incomplete) {
+            bad += scanned.length != 0;
+            break;
+        }
+        if (scanned.length == 0 || scanned.length > view.size()) {
+            bad++;
+            break;
+        }
+        if (scanned.kind == kitty::Scan::Kind::Key &&
+            !kitty::parse(view.substr(0, scanned.length))) {
+            bad++; // A key found by scan() must parse on its own
+        }
+        view.remove_prefix(scanned.length);
+    }
+    std::printf("  %-22s %zu scans over %zu random bytes, %zu bad\n", "fuzz", scans,
+                bytes.size(), bad);
+    return bad == 0 ? 0 : 1;
+}
+
+} // namespace
+
+int runKittyBench(size_t megabytes) {
+    std::mt19937 rng(SEED);
+    Stream stream = buildStream(megabytes << 20, rng);
+
+    std::printf("Kitty parser: %.1f MB stream, %zu key sequences\n",
+                stream.bytes.size() / 1048576.0, stream.keys.size());
+
+    int failures = 0;
+    std::vector<kitty::KeyEvent> found;
+    found.reserve(stream.keys.size());
+
+    kitty::forEachKey(stream.bytes, [&](const kitty::KeyEvent& key) { found.push_back(key); });
+    failures += checkKeys("whole buffer", stream.keys, found);
+
+    found.clear();
+    scanInReads(stream.bytes, rng, found);
+    failures += checkKeys("random reads", stream.keys, found);
+
+    failures += fuzzRandomBytes(rng);
+
+    // Throughput: keys are only counted, so scanning is all that is timed
+    double best_seconds = 1e9;
+    uint64_t checksum = 0;
+    uint64_t allocations = heapAllocationCount();
+    for (int pass = 0; pass < THROUGHPUT_PASSES; ++pass) {
+        auto start = std::chrono::steady_clock::now();
+        kitty::forEachKey(stream.bytes, [&](const kitty::KeyEvent& key) {
+            checksum += key.keycode + key.modifiers;
+        });
+        double seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        best_seconds = std::min(best_seconds, seconds);
+    }
+    allocations = heapAllocationCount() - allocations;
+
+    std::printf("  %-22s %.0f MB/s, %.1f ns/key, %llu allocations (checksum %llx)\n",
+                "throughput", stream.bytes.size() / 1048576.0 / best_seconds,
+                best_seconds * 1e9 / std::max<size_t>(1, stream.keys.size()),
+                static_cast<unsigned long long>(allocations),
+                static_cast<unsigned long long>(checksum));
+    failures += allocations != 0;
+
+    return failures == 0 ? 0 : 1;
+}
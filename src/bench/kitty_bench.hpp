@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstddef>
+
+// Generate a random terminal input stream (kitty key sequences in both
+// forms, other CSI replies, plain text) and check that kitty::forEachKey
+// finds exactly the keys that were written, whole and split into random
+// reads. Then scan random bytes for crashes and bad lengths, and print
+// parser throughput and heap allocations. Returns nonzero on a mismatch.
+int runKittyBench(size_t megabytes);
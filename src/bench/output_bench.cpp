@@ -0,0 +1,239 @@
+#include "bench/output_bench.hpp"
+#include "bench/bench_scene.hpp"
+#include "rendering/band_rasterizer.hpp"
+#include "rendering/draw_list.hpp"
+#include "rendering/pixel_canvas.hpp"
+#include "rendering/pixel_canvas_element.hpp"
+#include "terminal/frame_encoder.hpp"
+
+#include <ftxui/dom/node.hpp>
+#include <ftxui/screen/screen.hpp>
+#include <ftxui/screen/string.hpp>
+#include <ftxui/screen/terminal.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct OutputTotals {
+    size_t first_frame_bytes = 0;
+    size_t frame_bytes = 0;
+    size_t full_frame_bytes = 0;
+    size_t sgr_count = 0;
+};
+
+size_t countSgr(const std::string& bytes) {
+    size_t count = 0;
+    for (size_t i = 0; i + 1 < bytes.size(); ++i) {
+        if (bytes[i] != '\x1b' || bytes[i + 1] != '[') {
+            continue;
+        }
+        size_t j = i + 2;
+        while (j < bytes.size() && (bytes[j] == ';' || (bytes[j] >= '0' && bytes[j] <= '9'))) {
+            ++j;
+        }
+        if (j < bytes.size() && bytes[j] == 'm') {
+            ++count;
+        }
+    }
+    return count;
+}
+
+OutputTotals encodeFrames(int cols, int rows, int frames, const CellEncoder& cells, bool color) {
+    int width = cols * cells.cellWidth();
+    int height = rows * cells.cellHeight();
+
+    DrawList list;
+    PixelSprite mask;
+    PixelCanvas canvas;
+    canvas.resize(width, height, cells.cellWidth(), cells.cellHeight());
+    BandRasterizer rasterizer;
+    ftxui::Screen screen(cols, rows);
+    FrameEncoder encoder;
+    std::string out;
+
+    OutputTotals totals;
+    for (int frame = 0; frame <= frames; ++frame) {
+        list.clear();
+        buildBenchScene(list, mask, width, height, frame);
+        rasterizer.rasterize(list, canvas);
+
+        screen.Clear();
+        ftxui::Render(screen, pixelCanvasElement(canvas, cells, color));
+
+        out.clear();
+        encoder.encode(screen, out);
+        if (frame == 0) {
+            totals.first_frame_bytes = out.size(); // Full repaint
+            continue;
+        }
+        totals.frame_bytes += out.size();
+        totals.full_frame_bytes += screen.ToString().size();
+        totals.sgr_count += countSgr(out);
+    }
+    return totals;
+}
+
+// The characters a terminal shows after the encoder's bytes, one string
+// per column ("" for the right half of a wide glyph). Only understands what
+// FrameEncoder emits; styles are ignored.
+class TerminalModel {
+public:
+    TerminalModel(int cols, int rows) : cols_(cols), rows_(rows), cells_(cols * rows, " ") {}
+
+    void feed(const std::string& bytes) {
+        size_t i = 0;
+        while (i < bytes.size()) {
+            const unsigned char c = bytes[i];
+            if (c == '\x1b' && i + 1 < bytes.size() && bytes[i + 1] == '[') {
+                i = csi(bytes, i + 2);
+            } else if (c == '\r') {
+                x_ = 0;
+                ++i;
+            } else if (c == '\n') {
+                ++y_;
+                ++i;
+            } else {
+                const size_t length = c < 0x80 ? 1 : c < 0xE0 ? 2 : c < 0xF0 ? 3 : 4;
+                put(bytes.substr(i, length));
+                i += length;
+            }
+        }
+    }
+
+    const std::string& cell(int x, int y) const { return cells_[y * cols_ + x]; }
+
+private:
+    size_t csi(const std::string& bytes, size_t i) {
+        std::string params;
+        while (i < bytes.size() && (bytes[i] < 0x40 || bytes[i] > 0x7E)) {
+            params += bytes[i++];
+        }
+        const char final_byte = i < bytes.size() ? bytes[i] : 0;
+        const int first = params.empty() ? 1 : std::atoi(params.c_str());
+        if (final_byte == 'H') {
+            const size_t separator = params.find(';');
+            y_ = first - 1;
+            x_ = separator == std::string::npos ? 0 : std::atoi(params.c_str() + separator + 1) - 1;
+        } else if (final_byte == 'C') {
+            x_ += first;
+        } else if (final_byte == 'J' && params == "2") {
+            cells_.assign(cells_.size(), " ");
+        }
+        return i + 1;
+    }
+
+    void put(const std::string& glyph) {
+        if (x_ < 0 || x_ >= cols_ || y_ < 0 || y_ >= rows_) {
+            return;
+        }
+        std::string* row = &cells_[y_ * cols_];
+        // Writing over either half of a wide glyph blanks the other half
+        if (row[x_].empty() && x_ > 0) {
+            row[x_ - 1] = " ";
+        }
+        if (x_ + 1 < cols_ && row[x_ + 1].empty()) {
+            row[x_ + 1] = " ";
+        }
+        row[x_] = glyph;
+        if (ftxui::string_width(glyph) == 2 && x_ + 1 < cols_) {
+            row[x_ + 1].clear();
+            ++x_;
+        }
+        ++x_;
+    }
+
+    int cols_;
+    int rows_;
+    std::vector<std::string> cells_;
+    int x_ = 0;
+    int y_ = 0;
+};
+
+// Encode frames with cells nothing drew into and wide glyphs appearing,
+// moving and disappearing, and check the terminal ends up showing what
+// FTXUI's Screen::ToString would
+bool checkSparseAndWideCells() {
+    constexpr int COLS = 12;
+    constexpr int ROWS = 3;
+    struct Glyph {
+        int x, y;
+        const char* character;
+    };
+    const std::vector<std::vector<Glyph>> frames = {
+        {{1, 0, "\u5b57"}, {2, 0, ""}, {4, 0, "a"}, {8, 0, "b"},
+         {0, 1, "\u4e2d"}, {1, 1, ""}, {2, 1, "\u6587"}, {3, 1, ""}},
+        {{5, 0, "\u5b57"}, {6, 0, ""}, {8, 0, "b"},
+         {0, 1, "x"}, {2, 1, "\u6587"}, {3, 1, ""}, {0, 2, "y"}},
+        {{11, 2, "c"}},
+    };
+
+    ftxui::Screen screen(COLS, ROWS);
+    FrameEncoder encoder;
+    TerminalModel terminal(COLS, ROWS);
+    std::string out;
+
+    for (size_t frame = 0; frame < frames.size(); ++frame) {
+        for (int y = 0; y < ROWS; ++y) {
+            for (int x = 0; x < COLS; ++x) {
+                screen.PixelAt(x, y) = ftxui::Pixel();
+                screen.PixelAt(x, y).character.clear(); // Untouched
+            }
+        }
+        for (const Glyph& glyph : frames[frame]) {
+            screen.PixelAt(glyph.x, glyph.y).character = glyph.character;
+        }
+
+        out.clear();
+        encoder.encode(screen, out);
+        terminal.feed(out);
+
+        for (int y = 0; y < ROWS; ++y) {
+            bool continuation = false;
+            for (int x = 0; x < COLS; ++x) {
+                const std::string& character = screen.PixelAt(x, y).character;
+                const std::string expected = continuation ? "" : character.empty() ? " " : character;
+                if (terminal.cell(x, y) != expected) {
+                    std::printf("frame %zu cell %d,%d: expected \"%s\", terminal shows \"%s\"\n",
+                                frame, x, y, expected.c_str(), terminal.cell(x, y).c_str());
+                    return false;
+                }
+                continuation = ftxui::string_width(character) == 2;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int runOutputBench(int cols, int rows, int frames) {
+    if (!checkSparseAndWideCells()) {
+        std::printf("output bench: untouched/wide cell check FAILED\n");
+        return 1;
+    }
+
+    std::printf("output bench: %dx%d cells, %d scrolling frames, color support %d\n",
+                cols, rows, frames, static_cast<int>(ftxui::Terminal::ColorSupport()));
+    std::printf("%11s %6s %10s %14s %12s %10s\n", "cells", "color", "first B", "diff B/frame",
+                "full B/frame", "SGR/frame");
+
+    for (CellEncoding encoding : {CellEncoding::Braille, CellEncoding::Octant,
+                                  CellEncoding::HalfBlock}) {
+        const CellEncoder& cells = CellEncoder::get(encoding);
+        for (bool color : {true, false}) {
+            OutputTotals totals = encodeFrames(cols, rows, frames, cells, color);
+            std::printf("%11s %6s %10zu %14.0f %12.0f %10.1f\n",
+                        CellEncoder::name(encoding), color ? "on" : "off",
+                        totals.first_frame_bytes,
+                        static_cast<double>(totals.frame_bytes) / frames,
+                        static_cast<double>(totals.full_frame_bytes) / frames,
+                        static_cast<double>(totals.sgr_count) / frames);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+// Encode a scrolling synthetic game view with the terminal FrameEncoder for
+// each cell encoding, with the mask colored and without, and print the
+// bytes and SGR sequences per frame next to FTXUI's full repaint. First
+// checks that untouched (empty) cells and wide glyphs come out right;
+// returns nonzero if not.
+int runOutputBench(int cols, int rows, int frames);
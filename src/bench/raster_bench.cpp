@@ -0,0 +1,78 @@
+#include "bench/raster_bench.hpp"
+#include "bench/bench_scene.hpp"
+#include "rendering/band_rasterizer.hpp"
+#include "rendering/draw_list.hpp"
+#include "rendering/pixel_canvas.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+namespace {
+
+bool samePixels(const PixelCanvas& a, const PixelCanvas& b) {
+    for (int y = 0; y < a.height(); ++y) {
+        for (int w = 0; w < a.stride(); ++w) {
+            if (a.row(y)[w] != b.row(y)[w]) {
+                return false;
+            }
+        }
+    }
+    for (int cy = 0; cy < a.cellHeight(); ++cy) {
+        for (int cx = 0; cx < a.cellWidth(); ++cx) {
+            if (a.ink(cx, cy) != b.ink(cx, cy)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int runRasterBench(int cols, int rows, int frames, int max_threads) {
+    int width = cols * PixelCanvas::MAX_CELL_WIDTH;
+    int height = rows * PixelCanvas::MAX_CELL_HEIGHT;
+
+    DrawList list;
+    PixelSprite mask;
+    buildBenchScene(list, mask, width, height);
+
+    PixelCanvas reference;
+    reference.resize(width, height);
+    BandRasterizer(1).rasterize(list, reference);
+
+    std::printf("raster bench: %dx%d cells (%d sub-pixels), %zu commands, %d frames\n",
+                cols, rows, width * height, list.size(), frames);
+    std::printf("%8s %12s %9s %6s\n", "threads", "ms/frame", "speedup", "match");
+
+    if (max_threads <= 0) {
+        max_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    double single_ms = 0.0;
+    for (int threads = 1; threads <= max_threads; ++threads) {
+        BandRasterizer rasterizer(threads);
+        PixelCanvas canvas;
+        canvas.resize(width, height);
+
+        for (int i = 0; i < 10; ++i) {
+            rasterizer.rasterize(list, canvas);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < frames; ++i) {
+            rasterizer.rasterize(list, canvas);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        double ms = std::chrono::duration<double, std::milli>(elapsed).count() / frames;
+        if (threads == 1) {
+            single_ms = ms;
+        }
+
+        std::printf("%8d %12.4f %8.2fx %6s\n", threads, ms, single_ms / ms,
+                    samePixels(canvas, reference) ? "yes" : "NO");
+    }
+
+    return 0;
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+// Rasterize a synthetic game frame (terrain outline, ball fill, mask sprite)
+// with 1..N band threads and print the time per frame and speedup for each.
+// Also checks that every thread count produces the same pixels.
+// max_threads <= 0 uses the hardware thread count.
+int runRasterBench(int cols, int rows, int frames, int max_threads = 0);
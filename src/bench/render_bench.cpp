@@ -0,0 +1,296 @@
+#include "bench/render_bench.hpp"
+#include "config.hpp"
+#include "game/particle_system.hpp"
+#include "level/level_generator.hpp"
+#include "level/stdin_reader.hpp"
+#include "physics/softbody_ball.hpp"
+#include "rendering/ball_renderer.hpp"
+#include "rendering/band_rasterizer.hpp"
+#include "rendering/camera.hpp"
+#include "rendering/cell_encoder.hpp"
+#include "rendering/draw_list.hpp"
+#include "rendering/mask_renderer.hpp"
+#include "rendering/parallax_renderer.hpp"
+#include "rendering/particle_renderer.hpp"
+#include "rendering/pixel_canvas.hpp"
+#include "rendering/pixel_canvas_element.hpp"
+#include "rendering/terrain_renderer.hpp"
+#include "terminal/frame_encoder.hpp"
+#include "ui/text_bar.hpp"
+
+#include <ftxui/dom/elements.hpp>
+#include <ftxui/dom/node.hpp>
+#include <ftxui/screen/screen.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr float PAN_SPEED = 12.0f;   // Meters per second of camera travel
+constexpr float FRAME_DT = 1.0f / 60.0f;
+constexpr float PATH_START_X = 5.0f;
+constexpr float ZOOM_OUT = 0.25f;    // Furthest zoom reached mid-path
+constexpr float MAX_SPEED = 30.0f;   // Scripted ball speed mid-path, m/s
+constexpr int DUST_INTERVAL = 20;    // Frames between scripted touchdowns
+
+using Clock = std::chrono::steady_clock;
+
+// Per-frame samples of one metric
+class Samples {
+public:
+    void add(double value) { values_.push_back(value); }
+
+    double percentile(double p) {
+        if (values_.empty()) {
+            return 0.0;
+        }
+        size_t index = static_cast<size_t>(p * (values_.size() - 1) + 0.5);
+        std::nth_element(values_.begin(), values_.begin() + index, values_.end());
+        return values_[index];
+    }
+
+private:
+    std::vector<double> values_;
+};
+
+struct StageSamples {
+    Samples parallax_us;
+    Samples terrain_us;
+    Samples particles_us;
+    Samples ball_us;
+    Samples mask_us;
+    Samples record_us; // All of the above
+    Samples text_bar_us;
+    Samples raster_us;
+    Samples compose_us;
+    Samples encode_us;
+    Samples cells_inked;
+    Samples bytes;
+};
+
+double microsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+// Height of the terrain under x, or 0 off the generated level
+float terrainHeight(const std::vector<LevelSegment>& segments, float x) {
+    auto segment = std::partition_point(segments.begin(), segments.end(),
+        [&](const LevelSegment& s) { return s.end_x < x; });
+    if (segment == segments.end() || segment->sampled_points.empty()) {
+        return 0.0f;
+    }
+    // Sampled points run right to left
+    const auto& points = segment->sampled_points;
+    auto point = std::partition_point(points.begin(), points.end(),
+        [&](const b2Vec2& p) { return p.x > x; });
+    return point == points.end() ? points.back().y : point->y;
+}
+
+// Rim ring around the core, turning as the ball rolls
+void ballRing(b2Vec2 core, float angle, std::vector<b2Vec2>& rims) {
+    rims.clear();
+    for (int i = 0; i < SoftbodyBall::RIM_COUNT; ++i) {
+        float a = angle + 2.0f * static_cast<float>(M_PI) * i / SoftbodyBall::RIM_COUNT;
+        rims.push_back({core.x + SoftbodyBall::BALL_RADIUS * std::cos(a),
+                        core.y + SoftbodyBall::BALL_RADIUS * std::sin(a)});
+    }
+}
+
+int countInkedCells(const PixelCanvas& canvas) {
+    int count = 0;
+    for (int cy = 0; cy < canvas.cellHeight(); ++cy) {
+        for (int cx = 0; cx < canvas.cellWidth(); ++cx) {
+            count += canvas.cellMask(cx, cy) != 0;
+        }
+    }
+    return count;
+}
+
+StageSamples renderPath(const std::vector<LevelSegment>& segments, float path_length,
+                        int cols, int rows, int frames, const CellEncoder& cells,
+                        TerrainFill fill, bool background) {
+    Camera camera;
+    camera.setBasePixelsPerMeter(Camera::PIXELS_PER_METER * cells.cellWidth() / 2.0f);
+    camera.setScreenSize(cols * cells.cellWidth(), rows * cells.cellHeight());
+
+    ParallaxRenderer parallax_renderer;
+    TerrainRenderer terrain_renderer;
+    BallRenderer ball_renderer;
+    ParticleRenderer particle_renderer;
+    MaskRenderer mask_renderer(std::string(MASQUERADE_ASSETS_DIR) + "/mask.png");
+    TextBar text_bar;
+    DrawList list;
+    BandRasterizer rasterizer;
+    PixelCanvas canvas;
+    canvas.resize(cols * cells.cellWidth(), rows * cells.cellHeight(),
+                  cells.cellWidth(), cells.cellHeight());
+    ftxui::Screen screen(cols, rows);
+    FrameEncoder encoder;
+    std::string out;
+    std::vector<b2Vec2> rims;
+    ParticleSystem particles;
+    std::vector<b2Vec2> dust;
+    std::vector<b2Vec2> streaks;
+
+    StageSamples samples;
+    for (int frame = 0; frame < frames; ++frame) {
+        // Pan along the level, zooming out to ZOOM_OUT halfway and back
+        float t = static_cast<float>(frame) / std::max(1, frames - 1);
+        float x = PATH_START_X + t * path_length;
+        b2Vec2 core = {x, terrainHeight(segments, x) + SoftbodyBall::BALL_RADIUS};
+        float zoom = 1.0f - (1.0f - ZOOM_OUT) * std::sin(static_cast<float>(M_PI) * t);
+        camera.setZoom(zoom);
+        camera.update(core, 1.0f); // Snap to the scripted zoom
+        ballRing(core, -x / SoftbodyBall::BALL_RADIUS, rims);
+
+        // Speed peaks mid-path so the streaks come and go; dust on touchdowns
+        float speed = MAX_SPEED * std::sin(static_cast<float>(M_PI) * t);
+        if (frame % DUST_INTERVAL == 0) {
+            particles.spawnDust({core.x, core.y - SoftbodyBall::BALL_RADIUS}, {0.0f, 1.0f},
+                                speed * 0.3f);
+        }
+        for (int n = static_cast<int>(speed / 10.0f); n > 0; --n) {
+            particles.spawnStreak({core.x + 8.0f, core.y}, {20.0f, 8.0f});
+        }
+        particles.update(FRAME_DT);
+        dust.clear();
+        streaks.clear();
+        for (int i = 0; i < particles.size(); ++i) {
+            auto& points = particles.kind(i) == ParticleSystem::Kind::Dust ? dust : streaks;
+            points.push_back({particles.x(i), particles.y(i)});
+        }
+
+        // Each renderer on its own, then the whole record
+        const auto record_start = Clock::now();
+        auto start = record_start;
+        auto stage = [&](Samples& stage_samples) {
+            const auto now = Clock::now();
+            stage_samples.add(std::chrono::duration<double, std::micro>(now - start).count());
+            start = now;
+        };
+        list.clear();
+        if (background) {
+            parallax_renderer.draw(list, camera);
+            stage(samples.parallax_us);
+        }
+        terrain_renderer.draw(list, camera, segments, cells.cellWidth(), fill);
+        stage(samples.terrain_us);
+        particle_renderer.draw(list, camera, dust, streaks, speed);
+        stage(samples.particles_us);
+        ball_renderer.draw(list, camera, core, rims);
+        stage(samples.ball_us);
+        mask_renderer.draw(list, camera, {core.x, core.y + SoftbodyBall::BALL_RADIUS});
+        stage(samples.mask_us);
+        samples.record_us.add(microsSince(record_start));
+
+        start = Clock::now();
+        const std::string& text_row =
+            text_bar.layout(segments, camera.viewportLeft(), camera.viewportRight(), cols);
+        samples.text_bar_us.add(microsSince(start));
+
+        start = Clock::now();
+        rasterizer.rasterize(list, canvas);
+        samples.raster_us.add(microsSince(start));
+
+        // Same layering as the game view: canvas under the text bar
+        start = Clock::now();
+        using namespace ftxui;
+        auto view = dbox({
+            pixelCanvasElement(canvas, cells) | flex,
+            vbox({
+                filler() | flex_grow,
+                text(text_row) | border,
+                filler() | size(HEIGHT, EQUAL, 2),
+            }),
+        });
+        screen.Clear();
+        Render(screen, view);
+        samples.compose_us.add(microsSince(start));
+
+        start = Clock::now();
+        out.clear();
+        encoder.encode(screen, out);
+        samples.encode_us.add(microsSince(start));
+
+        samples.cells_inked.add(countInkedCells(canvas));
+        samples.bytes.add(static_cast<double>(out.size()));
+    }
+    return samples;
+}
+
+void printRow(const char* label, Samples& samples) {
+    std::printf("  %-14s %10.1f %10.1f %10.1f\n", label, samples.percentile(0.50),
+                samples.percentile(0.95), samples.percentile(0.99));
+}
+
+} // namespace
+
+int runRenderBench(int cols, int rows, int frames) {
+    // Let the reader finish so the whole level can be generated up front
+    StdinReader stdin_reader;
+    stdin_reader.start();
+    while (!stdin_reader.isEof()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    float path_length = frames * FRAME_DT * PAN_SPEED;
+    LevelGenerator generator(stdin_reader);
+    std::vector<LevelSegment> segments;
+    while (generator.currentX() < PATH_START_X + path_length && !generator.isLevelComplete()) {
+        auto segment = generator.generateNext();
+        if (!segment) {
+            break;
+        }
+        segments.push_back(std::move(*segment));
+    }
+    path_length = std::min(path_length, std::max(0.0f, generator.currentX() - PATH_START_X));
+
+    std::printf("render bench: %dx%d cells, %d frames over %.0f m, %zu segments\n",
+                cols, rows, frames, path_length, segments.size());
+
+    // Every encoding with the outline, then the filled terrain modes
+    struct Run {
+        CellEncoding encoding;
+        TerrainFill fill;
+        bool background;
+    };
+    constexpr Run runs[] = {
+        {CellEncoding::Braille, TerrainFill::Outline, false},
+        {CellEncoding::Octant, TerrainFill::Outline, false},
+        {CellEncoding::HalfBlock, TerrainFill::Outline, false},
+        {CellEncoding::Braille, TerrainFill::Solid, false},
+        {CellEncoding::Braille, TerrainFill::Dithered, false},
+        {CellEncoding::Braille, TerrainFill::Outline, true},
+    };
+    for (const Run& run : runs) {
+        StageSamples samples = renderPath(segments, path_length, cols, rows, frames,
+                                          CellEncoder::get(run.encoding), run.fill,
+                                          run.background);
+        std::printf("%-10s %-8s %-3s %4s %10s %10s\n", CellEncoder::name(run.encoding),
+                    TerrainRenderer::fillName(run.fill), run.background ? "bg" : "",
+                    "p50", "p95", "p99");
+        if (run.background) {
+            printRow("  parallax us", samples.parallax_us);
+        }
+        printRow("  terrain us", samples.terrain_us);
+        printRow("  particles us", samples.particles_us);
+        printRow("  ball us", samples.ball_us);
+        printRow("  mask us", samples.mask_us);
+        printRow("record us", samples.record_us);
+        printRow("text bar us", samples.text_bar_us);
+        printRow("raster us", samples.raster_us);
+        printRow("compose us", samples.compose_us);
+        printRow("encode us", samples.encode_us);
+        printRow("cells inked", samples.cells_inked);
+        printRow("bytes", samples.bytes);
+    }
+
+    return 0;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+// Render a level from stdin (or the lorem ipsum fallback) along a scripted
+// camera path - panning right while zooming out and back - without a TTY.
+// Each frame runs the real renderers into a DrawList, rasterizes it, lays
+// out the canvas and text bar on an offscreen ftxui::Screen and encodes it
+// with FrameEncoder. Prints p50/p95/p99 of each stage's time (every
+// renderer and the text bar on its own, FTXUI layout as "compose"), the
+// cells inked and the bytes encoded, for every cell encoding and terrain
+// fill, and once with the parallax background.
+int runRenderBench(int cols, int rows, int frames);
@@ -0,0 +1,200 @@
+#include "debug_log.hpp"
+#include "diagnostics/trace.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+
+namespace {
+
+constexpr const char* LEVEL_NAMES[] = {"DEBUG", "INFO", "WARN", "ERROR"};
+
+// "12:34:56.789 LEVEL "
+void appendPrefix(std::string& out, std::chrono::system_clock::time_point time, LogLevel level) {
+    const auto since_epoch = time.time_since_epoch();
+    const std::time_t seconds =
+        std::chrono::duration_cast<std::chrono::seconds>(since_epoch).count();
+    const auto millis =
+        std::chrono::duration_cast<std::chrono::milliseconds>(since_epoch).count() % 1000;
+    std::tm local{};
+    localtime_r(&seconds, &local);
+
+    char prefix[32];
+    std::snprintf(prefix, sizeof(prefix), "%02d:%02d:%02d.%03d %s ", local.tm_hour, local.tm_min,
+                  local.tm_sec, static_cast<int>(millis), LEVEL_NAMES[static_cast<int>(level)]);
+    out += prefix;
+}
+
+// Keep values on one line and unambiguous
+void appendQuoted(std::string& out, std::string_view text) {
+    out += '"';
+    for (char c : text) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:   out += c; break;
+        }
+    }
+    out += '"';
+}
+
+} // namespace
+
+DebugLog& DebugLog::instance() {
+    static DebugLog log;
+    return log;
+}
+
+DebugLog::DebugLog() {
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    file_ = std::fopen("/tmp/masquerade_debug.log", "w");
+    if (file_) {
+        log(LogLevel::Info, "log.started");
+        writer_ = std::thread(&DebugLog::writerLoop, this);
+    }
+}
+
+DebugLog::~DebugLog() {
+    if (!writer_.joinable()) {
+        return;
+    }
+    log(LogLevel::Info, "log.ended");
+    stopping_.store(true);
+    wake_epoch_.fetch_add(1);
+    wake_epoch_.notify_one();
+    writer_.join();
+    std::fclose(file_);
+}
+
+DebugLog::Slot* DebugLog::claim() {
+    if (!file_) {
+        return nullptr;
+    }
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+        Slot& slot = slots_[pos & (CAPACITY - 1)];
+        const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                return &slot;
+            }
+        } else if (diff < 0) {
+            return nullptr; // Full: the writer hasn't freed this slot yet
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void DebugLog::publish(Slot& slot) {
+    const size_t pos = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(pos + 1, std::memory_order_release);
+
+    // Pairs with the fence in writerLoop: either the writer sees this
+    // record when it rechecks, or we see it going to sleep
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_relaxed)) {
+        wake_epoch_.fetch_add(1, std::memory_order_release);
+        wake_epoch_.notify_one();
+    }
+}
+
+void DebugLog::setText(Record& record, Field& field, std::string_view text) {
+    const size_t length = std::min(text.size(), TEXT_BYTES - record.text_used);
+    std::memcpy(record.text.data() + record.text_used, text.data(), length);
+    field.kind = Kind::Text;
+    field.text_offset = record.text_used;
+    field.text_length = static_cast<uint16_t>(length);
+    record.text_used = static_cast<uint16_t>(record.text_used + length);
+}
+
+void DebugLog::writerLoop() {
+    TRACE_THREAD_NAME("log writer");
+
+    while (true) {
+        if (drain()) {
+            continue;
+        }
+        std::fflush(file_);
+        if (stopping_.load()) {
+            break;
+        }
+
+        const uint32_t epoch = wake_epoch_.load(std::memory_order_acquire);
+        sleeping_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const Slot& next = slots_[dequeue_pos_ & (CAPACITY - 1)];
+        if (next.sequence.load(std::memory_order_acquire) == dequeue_pos_ + 1 ||
+            stopping_.load()) {
+            sleeping_.store(false, std::memory_order_relaxed);
+            continue;
+        }
+        wake_epoch_.wait(epoch, std::memory_order_acquire);
+        sleeping_.store(false, std::memory_order_relaxed);
+    }
+}
+
+bool DebugLog::drain() {
+    bool wrote = false;
+    while (true) {
+        Slot& slot = slots_[dequeue_pos_ & (CAPACITY - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1) {
+            break;
+        }
+        writeRecord(slot.record);
+        slot.sequence.store(dequeue_pos_ + CAPACITY, std::memory_order_release);
+        dequeue_pos_++;
+        wrote = true;
+    }
+
+    const uint64_t dropped = dropped_.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+        line_.clear();
+        appendPrefix(line_, std::chrono::system_clock::now(), LogLevel::Warn);
+        line_ += "log.dropped count=" + std::to_string(dropped) + "\n";
+        std::fwrite(line_.data(), 1, line_.size(), file_);
+    }
+    return wrote;
+}
+
+void DebugLog::writeRecord(const Record& record) {
+    line_.clear();
+    appendPrefix(line_, record.time, record.level);
+    line_ += record.event;
+
+    char number[32];
+    for (int i = 0; i < record.field_count; ++i) {
+        const Field& field = record.fields[i];
+        line_ += ' ';
+        line_ += field.key;
+        line_ += '=';
+        switch (field.kind) {
+            case Kind::Int:
+                std::snprintf(number, sizeof(number), "%lld", static_cast<long long>(field.i));
+                line_ += number;
+                break;
+            case Kind::Uint:
+                std::snprintf(number, sizeof(number), "%llu",
+                              static_cast<unsigned long long>(field.u));
+                line_ += number;
+                break;
+            case Kind::Float:
+                std::snprintf(number, sizeof(number), "%.6g", field.f);
+                line_ += number;
+                break;
+            case Kind::Bool:
+                line_ += field.b ? "true" : "false";
+                break;
+            case Kind::Text:
+                appendQuoted(line_, {record.text.data() + field.text_offset, field.text_length});
+                break;
+        }
+    }
+    line_ += '\n';
+    std::fwrite(line_.data(), 1, line_.size(), file_);
+}
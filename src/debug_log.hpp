@@ -1,52 +1,177 @@
 #pragma once
 
-#include <fstream>
-#include <sstream>
-#include <mutex>
+#include <array>
+#include <atomic>
 #include <chrono>
-#include <iomanip>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
 
+enum class LogLevel : uint8_t { Debug, Info, Warn, Error };
+
+// Levels below this are compiled out (0 debug .. 3 error, 4 silences
+// everything). Set by CMake from MASQUERADE_LOG_LEVEL.
+#ifndef MASQUERADE_LOG_LEVEL
+#define MASQUERADE_LOG_LEVEL 0
+#endif
+
+// Structured log written to /tmp/masquerade_debug.log, one line per record:
+//
+//   12:34:56.789 DEBUG segment.generated index=3 text="Hello" start_x=1.5
+//
+// Callers copy an event name and key/value fields into a fixed slot of a
+// lock-free ring and return; they never format, lock or touch the file. A
+// background thread formats and writes the records, sleeping while the
+// ring is empty. When the ring is full, records are dropped and counted.
+//
+// Event names and keys must be string literals. Values may be numbers,
+// bools or strings (copied, truncated to fit the slot).
 class DebugLog {
 public:
-    static DebugLog& instance() {
-        static DebugLog log;
-        return log;
+    static DebugLog& instance();
+
+    template <typename... Fields>
+    void log(LogLevel level, const char* event, const Fields&... fields) {
+        static_assert(sizeof...(Fields) % 2 == 0, "fields are key, value pairs");
+        static_assert(sizeof...(Fields) / 2 <= MAX_FIELDS, "too many fields");
+
+        Slot* slot = claim();
+        if (!slot) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        Record& record = slot->record;
+        record.time = std::chrono::system_clock::now();
+        record.event = event;
+        record.level = level;
+        record.field_count = 0;
+        record.text_used = 0;
+        addFields(record, fields...);
+        publish(*slot);
     }
 
-    template<typename... Args>
-    void write(Args&&... args) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (!file_.is_open()) return;
+    DebugLog(const DebugLog&) = delete;
+    DebugLog& operator=(const DebugLog&) = delete;
 
-        auto now = std::chrono::system_clock::now();
-        auto time = std::chrono::system_clock::to_time_t(now);
-        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now.time_since_epoch()) % 1000;
+private:
+    static constexpr int MAX_FIELDS = 12;
+    static constexpr size_t TEXT_BYTES = 192; // String values of one record
+    static constexpr size_t CAPACITY = 1024;  // Records; power of two
 
-        file_ << std::put_time(std::localtime(&time), "%H:%M:%S")
-              << "." << std::setfill('0') << std::setw(3) << ms.count() << " ";
+    enum class Kind : uint8_t { Int, Uint, Float, Bool, Text };
 
-        ((file_ << std::forward<Args>(args)), ...);
-        file_ << std::endl;
-    }
+    struct Field {
+        const char* key;
+        Kind kind;
+        uint16_t text_offset;
+        uint16_t text_length;
+        union {
+            int64_t i;
+            uint64_t u;
+            double f;
+            bool b;
+        };
+    };
 
-private:
-    DebugLog() {
-        file_.open("/tmp/masquerade_debug.log", std::ios::out | std::ios::trunc);
-        if (file_.is_open()) {
-            write("=== Debug log started ===");
-        }
+    struct Record {
+        std::chrono::system_clock::time_point time;
+        const char* event;
+        LogLevel level;
+        uint8_t field_count;
+        uint16_t text_used;
+        std::array<Field, MAX_FIELDS> fields;
+        std::array<char, TEXT_BYTES> text;
+    };
+
+    // Bounded MPSC queue cell (Vyukov): `sequence` tells producers and the
+    // writer whose turn the slot is
+    struct Slot {
+        std::atomic<size_t> sequence;
+        Record record;
+    };
+
+    DebugLog();
+    ~DebugLog();
+
+    Slot* claim();
+    void publish(Slot& slot);
+    void writerLoop();
+    // Format and write everything queued; returns false if nothing was
+    bool drain();
+    void writeRecord(const Record& record);
+
+    static void addFields(Record&) {}
+
+    template <typename Value, typename... Rest>
+    static void addFields(Record& record, const char* key, const Value& value, const Rest&... rest) {
+        Field& field = record.fields[record.field_count++];
+        field.key = key;
+        setValue(record, field, value);
+        addFields(record, rest...);
     }
 
-    ~DebugLog() {
-        if (file_.is_open()) {
-            write("=== Debug log ended ===");
-            file_.close();
+    template <typename Value>
+    static void setValue(Record& record, Field& field, const Value& value) {
+        if constexpr (std::is_same_v<Value, bool>) {
+            field.kind = Kind::Bool;
+            field.b = value;
+        } else if constexpr (std::is_integral_v<Value> && std::is_signed_v<Value>) {
+            field.kind = Kind::Int;
+            field.i = value;
+        } else if constexpr (std::is_integral_v<Value>) {
+            field.kind = Kind::Uint;
+            field.u = value;
+        } else if constexpr (std::is_floating_point_v<Value>) {
+            field.kind = Kind::Float;
+            field.f = value;
+        } else {
+            setText(record, field, std::string_view(value));
         }
     }
 
-    std::ofstream file_;
-    std::mutex mutex_;
+    static void setText(Record& record, Field& field, std::string_view text);
+
+    std::array<Slot, CAPACITY> slots_;
+    std::atomic<size_t> enqueue_pos_{0};
+    size_t dequeue_pos_ = 0; // Writer thread only
+    std::atomic<uint64_t> dropped_{0};
+
+    // Writer sleep/wake (an event count: the writer announces it is about
+    // to sleep, rechecks the ring, then waits for the epoch to move)
+    std::atomic<bool> sleeping_{false};
+    std::atomic<uint32_t> wake_epoch_{0};
+    std::atomic<bool> stopping_{false};
+
+    std::FILE* file_ = nullptr;
+    std::string line_; // Writer thread's format buffer
+    std::thread writer_;
 };
 
-#define DEBUG_LOG(...) DebugLog::instance().write(__VA_ARGS__)
+#define LOG_AT_(level, ...) DebugLog::instance().log(level, __VA_ARGS__)
+
+#if MASQUERADE_LOG_LEVEL <= 0
+#define LOG_DEBUG(...) LOG_AT_(LogLevel::Debug, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+
+#if MASQUERADE_LOG_LEVEL <= 1
+#define LOG_INFO(...) LOG_AT_(LogLevel::Info, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+
+#if MASQUERADE_LOG_LEVEL <= 2
+#define LOG_WARN(...) LOG_AT_(LogLevel::Warn, __VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void)0)
+#endif
+
+#if MASQUERADE_LOG_LEVEL <= 3
+#define LOG_ERROR(...) LOG_AT_(LogLevel::Error, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
@@ -0,0 +1,65 @@
+#include "diagnostics/alloc_counter.hpp"
+#include "diagnostics/memory_tags.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+namespace {
+
+std::atomic<uint64_t> allocation_count{0};
+
+void* allocate(std::size_t size) noexcept {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    return memory::allocate(size, alignof(std::max_align_t));
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t align) noexcept {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    return memory::allocate(size, static_cast<std::size_t>(align));
+}
+
+void* orThrow(void* p) {
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+} // namespace
+
+uint64_t heapAllocationCount() {
+    return allocation_count.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size) { return orThrow(allocate(size)); }
+void* operator new[](std::size_t size) { return orThrow(allocate(size)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    return orThrow(allocateAligned(size, align));
+}
+void* operator new[](std::size_t size, std::align_val_t align) {
+    return orThrow(allocateAligned(size, align));
+}
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, align);
+}
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, align);
+}
+
+void operator delete(void* p) noexcept { memory::release(p); }
+void operator delete[](void* p) noexcept { memory::release(p); }
+void operator delete(void* p, std::size_t) noexcept { memory::release(p); }
+void operator delete[](void* p, std::size_t) noexcept { memory::release(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { memory::release(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { memory::release(p); }
+
+void operator delete(void* p, std::align_val_t) noexcept { memory::release(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { memory::release(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { memory::release(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { memory::release(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { memory::release(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { memory::release(p); }
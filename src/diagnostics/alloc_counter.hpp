@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstdint>
+
+// Heap allocations made through the global operator new on any thread
+// since startup. alloc_counter.cpp replaces the global allocation
+// functions with wrappers that bump one relaxed atomic and hand the block
+// to the tagged accounting in memory_tags.hpp.
+uint64_t heapAllocationCount();
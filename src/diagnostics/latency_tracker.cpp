@@ -0,0 +1,66 @@
+#include "diagnostics/latency_tracker.hpp"
+#include "debug_log.hpp"
+
+#include <algorithm>
+
+void LatencyTracker::Histogram::add(double ms) {
+    const int bucket = std::clamp(static_cast<int>(ms), 0, BUCKETS - 1);
+    buckets_[bucket]++;
+    count_++;
+    sum_ms_ += ms;
+    max_ms_ = std::max(max_ms_, ms);
+}
+
+double LatencyTracker::Histogram::percentileMs(double p) const {
+    if (count_ == 0) {
+        return 0.0;
+    }
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(p / 100.0 * count_ + 0.5));
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS - 1; ++i) {
+        seen += buckets_[i];
+        if (seen >= rank) {
+            return std::min(i + 1.0, max_ms_);
+        }
+    }
+    return max_ms_;
+}
+
+void LatencyTracker::inputApplied(uint64_t frame_id, const InputStamp& stamp) {
+    if (pending_count_ == MAX_PENDING) {
+        pending_head_ = (pending_head_ + 1) % MAX_PENDING;
+        pending_count_--;
+    }
+    pending_[(pending_head_ + pending_count_) % MAX_PENDING] = {frame_id, stamp};
+    pending_count_++;
+}
+
+void LatencyTracker::frameWritten(uint64_t frame_id, Clock::time_point time) {
+    // A frame also shows every input applied to frames dropped before it
+    while (pending_count_ > 0 && pending_[pending_head_].frame_id <= frame_id) {
+        const Pending& entry = pending_[pending_head_];
+        const double ms =
+            std::chrono::duration<double, std::milli>(time - entry.stamp.time).count();
+        histograms_[static_cast<int>(entry.stamp.path)].add(std::max(0.0, ms));
+        pending_head_ = (pending_head_ + 1) % MAX_PENDING;
+        pending_count_--;
+    }
+}
+
+void LatencyTracker::dump() const {
+    [[maybe_unused]] const char* names[] = {"kitty", "fallback"};
+    for (int i = 0; i < 2; ++i) {
+        const Histogram& h = histograms_[i];
+        LOG_INFO("latency.summary", "path", names[i], "n", h.count(),
+                 "mean_ms", h.meanMs(), "p50_ms", h.percentileMs(50),
+                 "p95_ms", h.percentileMs(95), "p99_ms", h.percentileMs(99),
+                 "max_ms", h.maxMs());
+        for (int b = 0; b < Histogram::BUCKETS; ++b) {
+            if (h.bucket(b) != 0) {
+                // The last bucket also holds everything slower
+                LOG_INFO("latency.bucket", "path", names[i], "ms", b,
+                         "overflow", b == Histogram::BUCKETS - 1, "count", h.bucket(b));
+            }
+        }
+    }
+}
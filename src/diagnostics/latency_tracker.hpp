@@ -0,0 +1,65 @@
+#pragma once
+
+#include "input/input_action.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+// Input-to-photon latency: from reading a key event to finishing the
+// terminal write of the first frame that reflects it. Kitty and fallback
+// input are tracked separately since fallback releases are inferred from
+// autorepeat timing. Fixed storage; nothing allocates per frame.
+class LatencyTracker {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // 1 ms buckets; the last one collects everything slower
+    class Histogram {
+    public:
+        static constexpr int BUCKETS = 64;
+
+        void add(double ms);
+        uint64_t bucket(int i) const { return buckets_[i]; }
+        uint64_t count() const { return count_; }
+        double meanMs() const { return count_ ? sum_ms_ / count_ : 0.0; }
+        double maxMs() const { return max_ms_; }
+        // Upper edge of the bucket holding the p-th percentile (0-100),
+        // capped at the slowest sample
+        double percentileMs(double p) const;
+
+    private:
+        std::array<uint64_t, BUCKETS> buckets_{};
+        uint64_t count_ = 0;
+        double sum_ms_ = 0.0;
+        double max_ms_ = 0.0;
+    };
+
+    // The simulation step feeding frame_id applied input stamped at `stamp`
+    void inputApplied(uint64_t frame_id, const InputStamp& stamp);
+    // Frame frame_id (and everything before it) finished reaching the terminal
+    void frameWritten(uint64_t frame_id, Clock::time_point time);
+
+    const Histogram& histogram(InputPath path) const {
+        return histograms_[static_cast<int>(path)];
+    }
+
+    // Summary of both paths to the debug log
+    void dump() const;
+
+private:
+    struct Pending {
+        uint64_t frame_id;
+        InputStamp stamp;
+    };
+
+    // Inputs waiting for their frame, oldest first. Frames that never get
+    // written (the terminal is behind) are rare, so when full the oldest
+    // entry is dropped.
+    static constexpr int MAX_PENDING = 64;
+    std::array<Pending, MAX_PENDING> pending_{};
+    int pending_head_ = 0;
+    int pending_count_ = 0;
+
+    std::array<Histogram, 2> histograms_;
+};
@@ -0,0 +1,180 @@
+#include "diagnostics/memory_tags.hpp"
+#include "debug_log.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+
+namespace {
+
+// Sits right before the block handed out; `offset` leads back to what
+// malloc returned (larger than the header for over-aligned blocks)
+struct Header {
+    uint64_t size;
+    uint32_t offset;
+    MemoryTag tag;
+    uint8_t pad[3];
+};
+static_assert(sizeof(Header) == 16, "header must keep malloc's 16-byte alignment");
+
+struct alignas(64) Counters {
+    std::atomic<int64_t> live_bytes{0};
+    std::atomic<int64_t> live_blocks{0};
+    std::atomic<int64_t> peak_bytes{0};
+    std::atomic<uint64_t> total_blocks{0};
+    std::atomic<int64_t> units{0};
+};
+
+// Constant-initialized: usable by allocations made before main
+constinit std::array<Counters, memory::TAG_COUNT> counters;
+constinit thread_local MemoryTag current_tag = MemoryTag::Other;
+
+void charge(MemoryTag tag, int64_t bytes) {
+    Counters& c = counters[static_cast<int>(tag)];
+    const int64_t live = c.live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    if (bytes > 0) {
+        c.live_blocks.fetch_add(1, std::memory_order_relaxed);
+        c.total_blocks.fetch_add(1, std::memory_order_relaxed);
+        // Racing raises may lose to each other; close enough for a peak
+        if (live > c.peak_bytes.load(std::memory_order_relaxed)) {
+            c.peak_bytes.store(live, std::memory_order_relaxed);
+        }
+    } else {
+        c.live_blocks.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+// "12.3 MB" style, into `out`
+void formatBytes(char* out, std::size_t capacity, double bytes) {
+    static const char* const UNITS[] = {"B", "KB", "MB", "GB"};
+    int unit = 0;
+    while (bytes >= 1024.0 && unit < 3) {
+        bytes /= 1024.0;
+        ++unit;
+    }
+    std::snprintf(out, capacity, unit == 0 ? "%.0f %s" : "%.1f %s", bytes, UNITS[unit]);
+}
+
+} // namespace
+
+namespace memory {
+
+void* allocate(std::size_t size, std::size_t alignment, MemoryTag tag) noexcept {
+    const std::size_t offset = std::max(sizeof(Header), alignment);
+    void* raw;
+    if (alignment <= alignof(std::max_align_t)) {
+        raw = std::malloc(offset + size);
+    } else {
+        // aligned_alloc wants the size rounded up to the alignment
+        raw = std::aligned_alloc(alignment, (offset + size + alignment - 1) / alignment * alignment);
+    }
+    if (raw == nullptr) {
+        return nullptr;
+    }
+
+    auto* block = static_cast<unsigned char*>(raw) + offset;
+    Header* header = reinterpret_cast<Header*>(block) - 1;
+    header->size = size;
+    header->offset = static_cast<uint32_t>(offset);
+    header->tag = tag;
+    charge(tag, static_cast<int64_t>(size));
+    return block;
+}
+
+void* allocate(std::size_t size, std::size_t alignment) noexcept {
+    return allocate(size, alignment, current_tag);
+}
+
+void release(void* p) noexcept {
+    if (p == nullptr) {
+        return;
+    }
+    const Header* header = static_cast<const Header*>(p) - 1;
+    charge(header->tag, -static_cast<int64_t>(header->size));
+    std::free(static_cast<unsigned char*>(p) - header->offset);
+}
+
+MemoryTag currentTag() {
+    return current_tag;
+}
+
+MemoryTag exchangeTag(MemoryTag tag) {
+    const MemoryTag previous = current_tag;
+    current_tag = tag;
+    return previous;
+}
+
+TagStats stats(MemoryTag tag) {
+    const Counters& c = counters[static_cast<int>(tag)];
+    TagStats s;
+    s.live_bytes = c.live_bytes.load(std::memory_order_relaxed);
+    s.live_blocks = c.live_blocks.load(std::memory_order_relaxed);
+    s.peak_bytes = c.peak_bytes.load(std::memory_order_relaxed);
+    s.total_blocks = c.total_blocks.load(std::memory_order_relaxed);
+    s.units = c.units.load(std::memory_order_relaxed);
+    return s;
+}
+
+void setUnits(MemoryTag tag, int64_t units) {
+    counters[static_cast<int>(tag)].units.store(units, std::memory_order_relaxed);
+}
+
+const char* unitName(MemoryTag tag) {
+    switch (tag) {
+        case MemoryTag::Reader:   return "line";
+        case MemoryTag::Segments: return "segment";
+        case MemoryTag::Box2D:    return "body";
+        default:                  return nullptr;
+    }
+}
+
+const char* tagName(MemoryTag tag) {
+    switch (tag) {
+        case MemoryTag::Other:    return "other";
+        case MemoryTag::Reader:   return "reader";
+        case MemoryTag::Segments: return "segments";
+        case MemoryTag::Box2D:    return "box2d";
+        case MemoryTag::Renderer: return "renderer";
+        case MemoryTag::Ftxui:    return "ftxui";
+        case MemoryTag::COUNT:    break;
+    }
+    return "?";
+}
+
+void printSummary(std::FILE* out) {
+    std::fprintf(out, "\n%-10s %12s %12s %12s %10s  %s\n", "memory", "live", "peak", "blocks",
+                 "units", "per unit");
+    for (int i = 0; i < TAG_COUNT; ++i) {
+        const auto tag = static_cast<MemoryTag>(i);
+        const TagStats s = stats(tag);
+        if (s.total_blocks == 0) {
+            continue;
+        }
+        char live[16], peak[16], per_unit[32] = "";
+        formatBytes(live, sizeof(live), static_cast<double>(s.live_bytes));
+        formatBytes(peak, sizeof(peak), static_cast<double>(s.peak_bytes));
+        if (unitName(tag) && s.units > 0) {
+            char bytes[16];
+            formatBytes(bytes, sizeof(bytes), static_cast<double>(s.live_bytes) / s.units);
+            std::snprintf(per_unit, sizeof(per_unit), "%s/%s", bytes, unitName(tag));
+        }
+        std::fprintf(out, "%-10s %12s %12s %12lld %10lld  %s\n", tagName(tag), live, peak,
+                     static_cast<long long>(s.live_blocks), static_cast<long long>(s.units),
+                     per_unit);
+    }
+}
+
+void logSnapshot() {
+    for (int i = 0; i < TAG_COUNT; ++i) {
+        const auto tag = static_cast<MemoryTag>(i);
+        [[maybe_unused]] const TagStats s = stats(tag);
+        [[maybe_unused]] const char* unit = unitName(tag);
+        LOG_INFO("memory.tag", "tag", tagName(tag), "live_bytes", s.live_bytes,
+                 "live_blocks", s.live_blocks, "peak_bytes", s.peak_bytes,
+                 "total_blocks", s.total_blocks, "units", s.units, "unit", unit ? unit : "",
+                 "bytes_per_unit", s.units > 0 ? static_cast<double>(s.live_bytes) / s.units : 0.0);
+    }
+}
+
+} // namespace memory
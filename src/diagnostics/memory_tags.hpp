@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+// Subsystems heap memory is charged to. Each allocation remembers its tag,
+// so it is credited back to the same one whichever thread frees it.
+enum class MemoryTag : uint8_t {
+    Other,
+    Reader,   // Level text lines cached by the stdin reader
+    Segments, // LevelSegment text, splines, samples and LOD
+    Box2D,    // Everything Box2D allocates (b2SetAllocator)
+    Renderer, // Frame snapshots, draw lists and canvases
+    Ftxui,    // UI layout and terminal output
+    COUNT
+};
+
+// Tagged allocation accounting. Every heap block carries a 16-byte header
+// with its size and tag; the global operator new (alloc_counter.cpp) and
+// Box2D's allocator hook both go through here. The tag comes from the
+// innermost MemoryScope on the allocating thread.
+namespace memory {
+
+inline constexpr int TAG_COUNT = static_cast<int>(MemoryTag::COUNT);
+
+void* allocate(std::size_t size, std::size_t alignment, MemoryTag tag) noexcept;
+void* allocate(std::size_t size, std::size_t alignment) noexcept; // Current tag
+void release(void* p) noexcept;
+
+MemoryTag currentTag();
+MemoryTag exchangeTag(MemoryTag tag); // Returns the previous tag
+
+struct TagStats {
+    int64_t live_bytes = 0; // Requested sizes, headers not included
+    int64_t live_blocks = 0;
+    int64_t peak_bytes = 0;
+    uint64_t total_blocks = 0;
+    int64_t units = 0; // Lines, segments or bodies held (see unitName)
+};
+TagStats stats(MemoryTag tag);
+
+// What the tag's bytes are divided by for a per-unit cost, e.g. lines for
+// the reader and segments for segment storage; nullptr if none
+void setUnits(MemoryTag tag, int64_t units);
+const char* unitName(MemoryTag tag);
+const char* tagName(MemoryTag tag);
+
+// Whole-run table (live, peak, per unit)
+void printSummary(std::FILE* out);
+// One structured log record per tag
+void logSnapshot();
+
+} // namespace memory
+
+// Charges this thread's allocations to `tag` until the scope ends
+class MemoryScope {
+public:
+    explicit MemoryScope(MemoryTag tag) : previous_(memory::exchangeTag(tag)) {}
+    ~MemoryScope() { memory::exchangeTag(previous_); }
+
+    MemoryScope(const MemoryScope&) = delete;
+    MemoryScope& operator=(const MemoryScope&) = delete;
+
+private:
+    MemoryTag previous_;
+};
+
+#define MEMORY_CONCAT_(a, b) a##b
+#define MEMORY_CONCAT(a, b) MEMORY_CONCAT_(a, b)
+#define MEMORY_SCOPE(tag) MemoryScope MEMORY_CONCAT(memory_scope_, __LINE__)(MemoryTag::tag)
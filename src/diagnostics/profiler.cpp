@@ -0,0 +1,191 @@
+#include "diagnostics/profiler.hpp"
+#include "diagnostics/trace.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+int Profiler::bucketOf(uint64_t ns) {
+    if (ns < 4) {
+        return static_cast<int>(ns);
+    }
+    // Four buckets per power of two: the top bit picks the octave, the two
+    // below it the quarter
+    const int msb = std::bit_width(ns) - 1;
+    const int quarter = static_cast<int>((ns >> (msb - 2)) & 3);
+    return std::min(msb * 4 + quarter - 4, BUCKETS - 1);
+}
+
+uint64_t Profiler::bucketUpperNs(int bucket) {
+    const int next = bucket + 1;
+    if (next < 4) {
+        return static_cast<uint64_t>(next);
+    }
+    const int msb = (next + 4) / 4;
+    const uint64_t quarter = static_cast<uint64_t>((next + 4) % 4);
+    return (4 + quarter) << (msb - 2);
+}
+
+void Profiler::record(ProfileZone zone, Clock::time_point begin, Clock::time_point end) {
+    TRACE_SPAN(zoneName(zone), begin, end);
+    recordDuration(zone, end - begin);
+}
+
+void Profiler::recordDuration(ProfileZone zone, Clock::duration elapsed) {
+    Zone& z = zones_[static_cast<int>(zone)];
+    const uint64_t ns = static_cast<uint64_t>(std::max<int64_t>(
+        0, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+
+    // Single writer per zone: plain load/store pairs, no read-modify-write
+    const uint64_t index = z.written.load(std::memory_order_relaxed);
+    z.ring[index % RING_SIZE].store(
+        static_cast<uint32_t>(std::min<uint64_t>(ns, std::numeric_limits<uint32_t>::max())),
+        std::memory_order_relaxed);
+    z.written.store(index + 1, std::memory_order_release);
+
+    auto& bucket = z.buckets[bucketOf(ns)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    z.total_ns.store(z.total_ns.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+    if (ns > z.max_ns.load(std::memory_order_relaxed)) {
+        z.max_ns.store(ns, std::memory_order_relaxed);
+    }
+}
+
+void Profiler::setGauge(ProfileGauge gauge, int64_t value) {
+    GaugeSlot& slot = gauges_[static_cast<int>(gauge)];
+    slot.last.store(value, std::memory_order_relaxed);
+    if (value > slot.peak.load(std::memory_order_relaxed)) {
+        slot.peak.store(value, std::memory_order_relaxed);
+    }
+}
+
+Profiler::Gauge Profiler::gauge(ProfileGauge gauge) const {
+    const GaugeSlot& slot = gauges_[static_cast<int>(gauge)];
+    return {slot.last.load(std::memory_order_relaxed), slot.peak.load(std::memory_order_relaxed)};
+}
+
+int Profiler::history(ProfileZone zone, float* out_us, int max) const {
+    const Zone& z = zones_[static_cast<int>(zone)];
+    const uint64_t written = z.written.load(std::memory_order_acquire);
+    const int count = static_cast<int>(std::min<uint64_t>({written, RING_SIZE,
+                                                           static_cast<uint64_t>(max)}));
+    for (int i = 0; i < count; ++i) {
+        const uint64_t index = written - count + i;
+        out_us[i] = z.ring[index % RING_SIZE].load(std::memory_order_relaxed) / 1000.0f;
+    }
+    return count;
+}
+
+Profiler::Recent Profiler::recent(ProfileZone zone) const {
+    std::array<float, RING_SIZE> samples;
+    Recent result;
+    result.count = history(zone, samples.data(), RING_SIZE);
+    if (result.count == 0) {
+        return result;
+    }
+
+    auto at = [&](double p) {
+        auto nth = samples.begin() + static_cast<int>(p * (result.count - 1) + 0.5);
+        std::nth_element(samples.begin(), nth, samples.begin() + result.count);
+        return static_cast<double>(*nth);
+    };
+    result.p50_us = at(0.50);
+    result.p99_us = at(0.99);
+    return result;
+}
+
+void Profiler::printSummary(std::FILE* out) const {
+    std::fprintf(out, "%-16s %10s %10s %10s %10s %10s\n",
+                 "zone", "count", "mean us", "p50 us", "p99 us", "max us");
+    for (int i = 0; i < ZONE_COUNT; ++i) {
+        const Zone& z = zones_[i];
+        std::array<uint64_t, BUCKETS> buckets;
+        uint64_t count = 0;
+        for (int b = 0; b < BUCKETS; ++b) {
+            buckets[b] = z.buckets[b].load(std::memory_order_relaxed);
+            count += buckets[b];
+        }
+        if (count == 0) {
+            continue;
+        }
+
+        // Percentiles resolve to the upper edge of their bucket
+        auto percentileUs = [&](double p) {
+            const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(p * count + 0.5));
+            uint64_t seen = 0;
+            for (int b = 0; b < BUCKETS; ++b) {
+                seen += buckets[b];
+                if (seen >= rank) {
+                    return std::min(bucketUpperNs(b), z.max_ns.load(std::memory_order_relaxed)) /
+                           1000.0;
+                }
+            }
+            return z.max_ns.load(std::memory_order_relaxed) / 1000.0;
+        };
+
+        std::fprintf(out, "%-16s %10llu %10.1f %10.1f %10.1f %10.1f\n",
+                     zoneName(static_cast<ProfileZone>(i)),
+                     static_cast<unsigned long long>(count),
+                     z.total_ns.load(std::memory_order_relaxed) / 1000.0 / count,
+                     percentileUs(0.50), percentileUs(0.99),
+                     z.max_ns.load(std::memory_order_relaxed) / 1000.0);
+    }
+
+    bool header = false;
+    for (int i = 0; i < GAUGE_COUNT; ++i) {
+        const Gauge g = gauge(static_cast<ProfileGauge>(i));
+        if (g.peak == 0) {
+            continue;
+        }
+        if (!header) {
+            std::fprintf(out, "\n%-16s %10s %10s\n", "gauge", "last", "peak");
+            header = true;
+        }
+        std::fprintf(out, "%-16s %10lld %10lld\n", gaugeName(static_cast<ProfileGauge>(i)),
+                     static_cast<long long>(g.last), static_cast<long long>(g.peak));
+    }
+}
+
+const char* Profiler::zoneName(ProfileZone zone) {
+    switch (zone) {
+        case ProfileZone::Frame:         return "frame";
+        case ProfileZone::Input:         return "input";
+        case ProfileZone::LevelGen:      return "level gen";
+        case ProfileZone::Physics:       return "physics";
+        case ProfileZone::PhysicsPairs:       return "  b2 pairs";
+        case ProfileZone::PhysicsCollide:     return "  b2 collide";
+        case ProfileZone::PhysicsSolve:       return "  b2 solve";
+        case ProfileZone::PhysicsConstraints: return "    constraints";
+        case ProfileZone::PhysicsContinuous:  return "    continuous";
+        case ProfileZone::PhysicsRefit:       return "    refit";
+        case ProfileZone::PhysicsIslands:     return "    islands";
+        case ProfileZone::Parallax:      return "parallax";
+        case ProfileZone::Particles:     return "particles";
+        case ProfileZone::Terrain:       return "terrain";
+        case ProfileZone::Ball:          return "ball";
+        case ProfileZone::Mask:          return "mask";
+        case ProfileZone::Raster:        return "raster";
+        case ProfileZone::TextBar:       return "text bar";
+        case ProfileZone::Layout:        return "ftxui layout";
+        case ProfileZone::TerminalWrite: return "terminal write";
+        case ProfileZone::COUNT:         break;
+    }
+    return "?";
+}
+
+const char* Profiler::gaugeName(ProfileGauge gauge) {
+    switch (gauge) {
+        case ProfileGauge::Bodies:   return "b2 bodies";
+        case ProfileGauge::Shapes:   return "b2 shapes";
+        case ProfileGauge::Contacts: return "b2 contacts";
+        case ProfileGauge::Joints:   return "b2 joints";
+        case ProfileGauge::Islands:  return "b2 islands";
+        case ProfileGauge::COUNT:    break;
+    }
+    return "?";
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+// Timed stages of a frame. Each zone is recorded by one thread only: the
+// render thread for the renderers and the rasterizer, the main thread for
+// the rest.
+enum class ProfileZone : uint8_t {
+    Frame,         // Main-thread work of a game step, wake to submit
+    Input,
+    LevelGen,
+    Physics,
+    // Box2D's own breakdown of the physics step (b2World_GetProfile)
+    PhysicsPairs,       // Broadphase pair updates
+    PhysicsCollide,     // Narrowphase contacts
+    PhysicsSolve,       // Whole solver stage, including the four below
+    PhysicsConstraints,
+    PhysicsContinuous,  // Bullets / time of impact
+    PhysicsRefit,       // Broadphase tree refit
+    PhysicsIslands,     // Island merge, split and sleep
+    Parallax,
+    Particles,
+    Terrain,
+    Ball,
+    Mask,
+    Raster,
+    TextBar,
+    Layout,        // FTXUI event handling, layout and draw (includes text bar)
+    TerminalWrite, // Frame encoding and write
+    COUNT
+};
+
+// Sizes sampled once per step; the summary reports the last and peak value
+enum class ProfileGauge : uint8_t {
+    Bodies,
+    Shapes,
+    Contacts,
+    Joints,
+    Islands,
+    COUNT
+};
+
+// Per-zone timings, lock-free. Each zone keeps a ring of its most recent
+// samples for the live overlay and a log-scale histogram of the whole
+// run for the exit summary. Readers on other threads may see a ring slot
+// being overwritten; for a statistics display that's fine.
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int ZONE_COUNT = static_cast<int>(ProfileZone::COUNT);
+    static constexpr int RING_SIZE = 128;
+
+    static Profiler& instance();
+
+    // Also a trace span when tracing is compiled in and recording
+    void record(ProfileZone zone, Clock::time_point begin, Clock::time_point end);
+    // A duration measured elsewhere (no trace span)
+    void recordDuration(ProfileZone zone, Clock::duration elapsed);
+
+    struct Gauge {
+        int64_t last = 0;
+        int64_t peak = 0;
+    };
+    // Single writer per gauge
+    void setGauge(ProfileGauge gauge, int64_t value);
+    Gauge gauge(ProfileGauge gauge) const;
+
+    // Statistics of the samples currently in the ring
+    struct Recent {
+        int count = 0;
+        double p50_us = 0.0;
+        double p99_us = 0.0;
+    };
+    Recent recent(ProfileZone zone) const;
+
+    // Up to `max` most recent samples, oldest first, in microseconds
+    int history(ProfileZone zone, float* out_us, int max) const;
+
+    // Whole-run table of every zone that recorded anything, then gauges
+    void printSummary(std::FILE* out) const;
+
+    static const char* zoneName(ProfileZone zone);
+    static const char* gaugeName(ProfileGauge gauge);
+
+private:
+    Profiler() = default;
+
+    // Quarter-octave buckets of nanoseconds, up to about 18 minutes
+    static constexpr int BUCKETS = 160;
+    static int bucketOf(uint64_t ns);
+    static uint64_t bucketUpperNs(int bucket);
+
+    struct Zone {
+        std::array<std::atomic<uint32_t>, RING_SIZE> ring{}; // Nanoseconds
+        std::atomic<uint64_t> written{0};
+        std::array<std::atomic<uint64_t>, BUCKETS> buckets{};
+        std::atomic<uint64_t> total_ns{0};
+        std::atomic<uint64_t> max_ns{0};
+    };
+    std::array<Zone, ZONE_COUNT> zones_;
+
+    struct GaugeSlot {
+        std::atomic<int64_t> last{0};
+        std::atomic<int64_t> peak{0};
+    };
+    static constexpr int GAUGE_COUNT = static_cast<int>(ProfileGauge::COUNT);
+    std::array<GaugeSlot, GAUGE_COUNT> gauges_;
+};
+
+// Records the time from construction to destruction
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfileZone zone)
+        : zone_(zone), start_(Profiler::Clock::now()) {}
+    ~ProfileScope() { Profiler::instance().record(zone_, start_, Profiler::Clock::now()); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfileZone zone_;
+    Profiler::Clock::time_point start_;
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(zone) ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(ProfileZone::zone)
@@ -0,0 +1,170 @@
+#include "diagnostics/trace.hpp"
+
+#include <array>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace trace {
+
+std::atomic<bool> g_recording{false};
+
+namespace {
+
+struct Event {
+    const char* name;
+    int64_t ts_ns;  // Since the trace started
+    int64_t value;  // Duration for spans, value for counters, id for instants
+    char phase;     // Chrome trace phase: 'X', 'C' or 'i'
+};
+
+// Grows a block at a time so events never move while stop() reads them.
+// Only the owning thread writes; `count` publishes the events.
+struct ThreadBuffer {
+    static constexpr size_t BLOCK_EVENTS = 16384;
+    static constexpr size_t MAX_BLOCKS = 64; // About a million events per thread
+
+    uint32_t tid = 0;
+    std::atomic<const char*> name{nullptr};
+    std::array<std::unique_ptr<Event[]>, MAX_BLOCKS> blocks;
+    std::atomic<size_t> count{0};
+    std::atomic<uint64_t> dropped{0};
+
+    void push(const Event& event) {
+        const size_t index = count.load(std::memory_order_relaxed);
+        const size_t block = index / BLOCK_EVENTS;
+        if (block >= MAX_BLOCKS) {
+            dropped.store(dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return;
+        }
+        if (!blocks[block]) {
+            blocks[block] = std::make_unique<Event[]>(BLOCK_EVENTS);
+        }
+        blocks[block][index % BLOCK_EVENTS] = event;
+        count.store(index + 1, std::memory_order_release);
+    }
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers; // Kept after their thread exits
+    std::string path;
+    Clock::time_point origin;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+thread_local ThreadBuffer* t_buffer = nullptr;
+
+ThreadBuffer& threadBuffer() {
+    if (!t_buffer) {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.buffers.push_back(std::make_unique<ThreadBuffer>());
+        t_buffer = r.buffers.back().get();
+        t_buffer->tid = static_cast<uint32_t>(r.buffers.size());
+    }
+    return *t_buffer;
+}
+
+int64_t sinceOrigin(Clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time - registry().origin).count();
+}
+
+} // namespace
+
+bool start(const char* path) {
+#ifdef MASQUERADE_TRACING
+    Registry& r = registry();
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.path = path;
+        r.origin = Clock::now();
+    }
+    g_recording.store(true, std::memory_order_release);
+    return true;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+void stop() {
+    if (!g_recording.exchange(false)) {
+        return;
+    }
+
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    std::FILE* out = std::fopen(r.path.c_str(), "w");
+    if (!out) {
+        return;
+    }
+
+    std::fprintf(out, "{\"traceEvents\":[\n");
+    const char* separator = "";
+    for (const auto& buffer : r.buffers) {
+        const char* name = buffer->name.load(std::memory_order_acquire);
+        std::fprintf(out, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                          "\"args\":{\"name\":\"%s\"}}",
+                     separator, buffer->tid, name ? name : "thread");
+        separator = ",\n";
+
+        const size_t count = buffer->count.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; ++i) {
+            const Event& e = buffer->blocks[i / ThreadBuffer::BLOCK_EVENTS]
+                                           [i % ThreadBuffer::BLOCK_EVENTS];
+            const double ts_us = e.ts_ns / 1000.0;
+            switch (e.phase) {
+                case 'X':
+                    std::fprintf(out, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+                                      "\"ts\":%.3f,\"dur\":%.3f}",
+                                 e.name, buffer->tid, ts_us, e.value / 1000.0);
+                    break;
+                case 'C':
+                    std::fprintf(out, ",\n{\"name\":\"%s\",\"ph\":\"C\",\"pid\":1,\"tid\":%u,"
+                                      "\"ts\":%.3f,\"args\":{\"value\":%lld}}",
+                                 e.name, buffer->tid, ts_us, static_cast<long long>(e.value));
+                    break;
+                case 'i':
+                    std::fprintf(out, ",\n{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,"
+                                      "\"tid\":%u,\"ts\":%.3f,\"args\":{\"id\":%lld}}",
+                                 e.name, buffer->tid, ts_us, static_cast<long long>(e.value));
+                    break;
+            }
+        }
+
+        const uint64_t dropped = buffer->dropped.load(std::memory_order_relaxed);
+        if (dropped > 0) {
+            std::fprintf(stderr, "trace: thread %u dropped %llu events (buffer full)\n",
+                         buffer->tid, static_cast<unsigned long long>(dropped));
+        }
+    }
+    std::fprintf(out, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    std::fclose(out);
+}
+
+void setThreadName(const char* name) {
+    threadBuffer().name.store(name, std::memory_order_release);
+}
+
+void complete(const char* name, Clock::time_point begin, Clock::time_point end) {
+    threadBuffer().push({name, sinceOrigin(begin),
+                         std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count(),
+                         'X'});
+}
+
+void counter(const char* name, int64_t value) {
+    threadBuffer().push({name, sinceOrigin(Clock::now()), value, 'C'});
+}
+
+void instant(const char* name, int64_t id) {
+    threadBuffer().push({name, sinceOrigin(Clock::now()), id, 'i'});
+}
+
+} // namespace trace
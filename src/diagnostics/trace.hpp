@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Chrome trace-event recording (open the output in Perfetto or
+// chrome://tracing). Each thread appends to a buffer of its own, so
+// recording takes no locks; the buffers are written out as JSON by
+// stop(). While not recording, every hook costs one atomic load.
+//
+// The TRACE_* macros compile to nothing unless the build defines
+// MASQUERADE_TRACING (CMake option ENABLE_TRACING). Event names must be
+// string literals or otherwise outlive the trace.
+namespace trace {
+
+using Clock = std::chrono::steady_clock;
+
+// Start recording; the trace goes to `path` on stop(). Returns false if
+// tracing was compiled out.
+bool start(const char* path);
+// Stop recording and write the file. Call once the traced threads are done.
+void stop();
+
+extern std::atomic<bool> g_recording;
+inline bool recording() { return g_recording.load(std::memory_order_acquire); }
+
+// Label the calling thread in the trace
+void setThreadName(const char* name);
+
+// A span on the calling thread
+void complete(const char* name, Clock::time_point begin, Clock::time_point end);
+// A counter track sample
+void counter(const char* name, int64_t value);
+// A global instant marker, with an id to tell them apart (frame number)
+void instant(const char* name, int64_t id);
+
+// Records a span from construction to destruction
+class Scope {
+public:
+    explicit Scope(const char* name)
+        : name_(recording() ? name : nullptr), begin_(name_ ? Clock::now() : Clock::time_point{}) {}
+    ~Scope() {
+        if (name_) {
+            complete(name_, begin_, Clock::now());
+        }
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    const char* name_;
+    Clock::time_point begin_;
+};
+
+} // namespace trace
+
+#ifdef MASQUERADE_TRACING
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) trace::Scope TRACE_CONCAT(trace_scope_, __LINE__)(name)
+#define TRACE_SPAN(name, begin, end) \
+    do { if (trace::recording()) trace::complete(name, begin, end); } while (0)
+// The value is only evaluated while recording
+#define TRACE_COUNTER(name, value) \
+    do { if (trace::recording()) trace::counter(name, value); } while (0)
+#define TRACE_INSTANT(name, id) \
+    do { if (trace::recording()) trace::instant(name, id); } while (0)
+#define TRACE_THREAD_NAME(name) trace::setThreadName(name)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_SPAN(name, begin, end) ((void)0)
+#define TRACE_COUNTER(name, value) ((void)0)
+#define TRACE_INSTANT(name, id) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#endif
@@ -1,4 +1,9 @@
 #include "game/game_session.hpp"
+#include "diagnostics/memory_tags.hpp"
+#include "diagnostics/profiler.hpp"
+#include "diagnostics/trace.hpp"
+
+#include <utility>
 
 GameSession::GameSession(StdinReader& stdin_reader)
     : terrain_(physics_.worldId()),
@@ -11,13 +16,17 @@ GameSession::GameSession(StdinReader& stdin_reader)
     last_ball_x_ = start_pos.x;
 
     // Generate initial terrain segments
-    for (int i = 0; i < 5; ++i) {
-        auto seg_opt = level_gen_.generateNext();
-        if (seg_opt) {
-            segments_.push_back(*seg_opt);
-            terrain_.addSegment(seg_opt->sampled_points);
+    {
+        MEMORY_SCOPE(Segments);
+        for (int i = 0; i < 5; ++i) {
+            auto seg_opt = level_gen_.generateNext();
+            if (seg_opt) {
+                terrain_.addSegment(seg_opt->sampled_points);
+                segments_.push_back(std::move(*seg_opt));
+            }
         }
     }
+    memory::setUnits(MemoryTag::Segments, static_cast<int64_t>(segments_.size()));
 }
 
 void GameSession::update(float dt, const InputSnapshot& input) {
@@ -28,7 +37,10 @@ void GameSession::update(float dt, const InputSnapshot& input) {
     elapsed_time_ += dt;
 
     // Process input
-    processInput(input, dt);
+    processInput(input);
+    if (input.event && (!applied_input_ || input.event->time < applied_input_->time)) {
+        applied_input_ = input.event;
+    }
 
     // Step physics
     physics_.step(dt);
@@ -43,6 +55,9 @@ void GameSession::update(float dt, const InputSnapshot& input) {
     }
     last_ball_x_ = ball_pos.x;
 
+    spawnParticles(dt);
+    particles_.update(dt);
+
     // Generate terrain ahead
     generateAheadOfCamera();
 
@@ -51,7 +66,7 @@ void GameSession::update(float dt, const InputSnapshot& input) {
     checkGoalReached();
 }
 
-void GameSession::processInput(const InputSnapshot& input, float dt) {
+void GameSession::processInput(const InputSnapshot& input) {
     // Horizontal movement
     if (input.move_left || input.horizontal_axis < -0.1f) {
         ball_->applyMovement(-1.0f);
@@ -65,8 +80,10 @@ void GameSession::processInput(const InputSnapshot& input, float dt) {
         jump_held_ = true;
     }
 
-    if (jump_held_ && input.jump_held) {
-        ball_->updateCompression(dt);
+    // Charge from the key's real hold time, including the final stretch of
+    // a press released between steps
+    if (jump_held_ && (input.jump_held || input.jump_just_released)) {
+        ball_->updateCompression(input.jump_held_seconds);
     }
 
     if (input.jump_just_released && jump_held_) {
@@ -82,22 +99,58 @@ void GameSession::processInput(const InputSnapshot& input, float dt) {
     }
 }
 
+void GameSession::spawnParticles(float dt) {
+    // Dust where a rim hits the (static) terrain hard enough to register
+    b2ContactEvents events = b2World_GetContactEvents(physics_.worldId());
+    for (int i = 0; i < events.hitCount; ++i) {
+        const b2ContactHitEvent& hit = events.hitEvents[i];
+        b2BodyId body_a = b2Shape_GetBody(hit.shapeIdA);
+        b2BodyId body_b = b2Shape_GetBody(hit.shapeIdB);
+        bool rim_is_a = ball_->isRim(body_a);
+        b2BodyId other = rim_is_a ? body_b : body_a;
+        if ((!rim_is_a && !ball_->isRim(body_b)) || b2Body_GetType(other) != b2_staticBody) {
+            continue;
+        }
+        // The normal points from A to B; dust leaves the ground
+        b2Vec2 normal = rim_is_a ? b2Neg(hit.normal) : hit.normal;
+        particles_.spawnDust(hit.point, normal, hit.approachSpeed);
+    }
+
+    // Speed lines around the view while the multiplier is high
+    float excess = scoring_.multiplier() - STREAK_MULTIPLIER;
+    if (excess <= 0.0f) {
+        streak_budget_ = 0.0f;
+        return;
+    }
+    streak_budget_ += excess * STREAK_RATE * dt;
+    b2Vec2 ball_pos = ball_->getCenterPosition();
+    for (; streak_budget_ >= 1.0f; streak_budget_ -= 1.0f) {
+        particles_.spawnStreak({ball_pos.x + 8.0f, ball_pos.y}, {20.0f, 8.0f});
+    }
+}
+
 void GameSession::generateAheadOfCamera() {
+    PROFILE_SCOPE(LevelGen);
+    MEMORY_SCOPE(Segments);
     b2Vec2 ball_pos = ball_->getCenterPosition();
-    float generation_horizon = ball_pos.x + 50.0f; // Generate 50 units ahead
+    float generation_horizon = ball_pos.x + look_ahead_;
 
     int generated_count = 0;
     while (level_gen_.currentX() < generation_horizon && !level_gen_.isLevelComplete()) {
         auto seg_opt = level_gen_.generateNext();
         if (seg_opt) {
-            segments_.push_back(*seg_opt);
             terrain_.addSegment(seg_opt->sampled_points);
+            segments_.push_back(std::move(*seg_opt));
             generated_count++;
         } else {
             break;
         }
     }
 
+    if (generated_count > 0) {
+        TRACE_COUNTER("segments live", static_cast<int64_t>(segments_.size()));
+        memory::setUnits(MemoryTag::Segments, static_cast<int64_t>(segments_.size()));
+    }
 }
 
 
@@ -153,6 +206,8 @@ void GameSession::restart() {
 
     // Reset scoring
     scoring_.reset();
+    particles_.clear();
+    streak_budget_ = 0.0f;
 
     // Reset level generator state
     level_gen_.reset();
@@ -168,13 +223,18 @@ void GameSession::restart() {
     elapsed_time_ = 0.0f;
     last_ball_x_ = start_pos.x;
     jump_held_ = false;
+    applied_input_.reset();
 
     // Regenerate initial terrain
-    for (int i = 0; i < 5; ++i) {
-        auto seg_opt = level_gen_.generateNext();
-        if (seg_opt) {
-            segments_.push_back(*seg_opt);
-            terrain_.addSegment(seg_opt->sampled_points);
+    {
+        MEMORY_SCOPE(Segments);
+        for (int i = 0; i < 5; ++i) {
+            auto seg_opt = level_gen_.generateNext();
+            if (seg_opt) {
+                terrain_.addSegment(seg_opt->sampled_points);
+                segments_.push_back(std::move(*seg_opt));
+            }
         }
     }
+    memory::setUnits(MemoryTag::Segments, static_cast<int64_t>(segments_.size()));
 }
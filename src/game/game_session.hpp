@@ -1,5 +1,6 @@
 #pragma once
 
+#include "game/particle_system.hpp"
 #include "game/scoring.hpp"
 #include "physics/physics_world.hpp"
 #include "physics/softbody_ball.hpp"
@@ -9,7 +10,10 @@
 #include "level/level_segment.hpp"
 #include "input/input_action.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <optional>
+#include <utility>
 #include <vector>
 
 class GameSession {
@@ -22,6 +26,7 @@ public:
     const SoftbodyBall& ball() const { return *ball_; }
     const MaskBody& mask() const { return *mask_; }
     const std::vector<LevelSegment>& segments() const { return segments_; }
+    const ParticleSystem& particles() const { return particles_; }
     int score() const { return scoring_.score(); }
     float speedMultiplier() const { return scoring_.multiplier(); }
     bool isGameOver() const { return game_over_; }
@@ -29,6 +34,15 @@ public:
 
     void restart();
 
+    // Stamp of the oldest input applied since the last call, if any
+    std::optional<InputStamp> takeAppliedInput() {
+        return std::exchange(applied_input_, std::nullopt);
+    }
+
+    // Keep terrain generated at least this far ahead of the ball (grows
+    // with the visible width when the camera zooms out)
+    void setLookAhead(float meters) { look_ahead_ = std::max(MIN_LOOK_AHEAD, meters); }
+
     PhysicsWorld& physics() { return physics_; }
 
 private:
@@ -38,8 +52,15 @@ private:
     TerrainBody terrain_;
     LevelGenerator level_gen_;
     Scoring scoring_;
+    ParticleSystem particles_;
+    float streak_budget_ = 0.0f; // Fractional streaks carried between steps
+
+    static constexpr float MIN_LOOK_AHEAD = 50.0f;
+    static constexpr float STREAK_MULTIPLIER = 2.5f; // Speed lines above this
+    static constexpr float STREAK_RATE = 60.0f;      // Per second per multiplier step
 
     std::vector<LevelSegment> segments_;
+    float look_ahead_ = MIN_LOOK_AHEAD;
     float elapsed_time_ = 0.0f;
     bool game_over_ = false;
     bool level_complete_ = false;
@@ -48,8 +69,11 @@ private:
     // Jump state
     bool jump_held_ = false;
 
-    void processInput(const InputSnapshot& input, float dt);
+    std::optional<InputStamp> applied_input_;
+
+    void processInput(const InputSnapshot& input);
     void generateAheadOfCamera();
+    void spawnParticles(float dt);
     void checkFallOffWorld();
     void checkGoalReached();
 };
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <box2d/box2d.h>
+
+#include <array>
+#include <cstdint>
+#include <random>
+
+// Counters shown in the debug overlay
+struct ParticleStats {
+    int live = 0;
+    uint64_t dropped = 0;    // Spawns refused because the pool was full
+    float update_us = 0.0f;  // Time spent in the last update()
+};
+
+// Fixed-capacity particle pool for impact dust and speed streaks, in world
+// space. Storage is structure-of-arrays inside the object, so spawning and
+// updating never allocate. Integration runs whole SIMD blocks: slots past
+// the live count are dead padding, so no scalar tail is needed. Dead
+// particles are swapped with the last live one.
+class ParticleSystem {
+public:
+    static constexpr int CAPACITY = 1024;
+    static constexpr int SIMD_WIDTH = 8; // Floats per AVX register
+    static_assert(CAPACITY % SIMD_WIDTH == 0, "update() rounds the count up to SIMD_WIDTH");
+
+    enum class Kind : uint8_t { Dust, Streak };
+
+    // Burst of dust thrown off a surface along its normal; approach_speed
+    // is how hard the contact hit (m/s)
+    void spawnDust(b2Vec2 point, b2Vec2 normal, float approach_speed);
+
+    // Motionless streak at a random point within half_extent of center;
+    // drawn as a blur line while the ball is fast
+    void spawnStreak(b2Vec2 center, b2Vec2 half_extent);
+
+    void update(float dt);
+    void clear();
+
+    int size() const { return count_; }
+    float x(int i) const { return x_[i]; }
+    float y(int i) const { return y_[i]; }
+    Kind kind(int i) const { return kind_[i]; }
+
+    const ParticleStats& stats() const { return stats_; }
+
+private:
+    static constexpr float DUST_GRAVITY = -12.0f;
+    static constexpr float DUST_LIFE = 0.6f;   // Seconds, before jitter
+    static constexpr float STREAK_LIFE = 0.35f;
+
+    int allocate();
+
+    alignas(32) std::array<float, CAPACITY> x_{};
+    alignas(32) std::array<float, CAPACITY> y_{};
+    alignas(32) std::array<float, CAPACITY> vx_{};
+    alignas(32) std::array<float, CAPACITY> vy_{};
+    alignas(32) std::array<float, CAPACITY> gravity_{};
+    alignas(32) std::array<float, CAPACITY> life_{};
+    std::array<Kind, CAPACITY> kind_{};
+    int count_ = 0;
+
+    std::minstd_rand rng_{0x5EED};
+    ParticleStats stats_;
+};
@@ -1,5 +1,20 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+// Which way a key event reached us: kitty sequences (real releases,
+// possibly read on the input thread) or plain FTXUI events with
+// autorepeat-based release
+enum class InputPath : uint8_t { Kitty, Fallback };
+
+// When a key event that changed input state was read
+struct InputStamp {
+    std::chrono::steady_clock::time_point time{};
+    InputPath path = InputPath::Fallback;
+};
+
 struct InputSnapshot {
     bool move_left = false;
     bool move_right = false;
@@ -8,8 +23,14 @@ struct InputSnapshot {
     bool jump_held = false;
     bool jump_just_pressed = false;
     bool jump_just_released = false;
+    // How long jump has been down (or was down, on the release step),
+    // from key event timestamps rather than frames
+    float jump_held_seconds = 0.0f;
     bool confirm = false;
     bool back = false;
     bool pause = false;
     float horizontal_axis = 0.0f; // -1.0 (left) to 1.0 (right)
+    // Oldest state-changing key event since the previous snapshot
+    // (input-to-photon latency)
+    std::optional<InputStamp> event;
 };
@@ -11,31 +11,23 @@ bool InputManager::handleFtxuiEvent(const ftxui::Event& event) {
     return consumed;
 }
 
-bool InputManager::handleRawEvent(const ftxui::Event& event) {
-    // Try to parse as a kitty keyboard protocol sequence
-    auto kitty_event = kitty::parse(event.input());
-    if (kitty_event) {
-        // Mark kitty protocol as confirmed working
-        kitty_confirmed_ = true;
-
-        auto game_key = kitty::toGameKey(kitty_event->keycode);
-
-        switch (kitty_event->event_type) {
-            case kitty::EventType::Press:
-            case kitty::EventType::Repeat:
-                keyboard_.handlePress(game_key);
-                break;
-            case kitty::EventType::Release:
-                keyboard_.handleRelease(game_key);
-                break;
-        }
-
-        active_source_ = ActiveSource::Keyboard;
-        return true;
+void InputManager::handleKeyEvent(const TimedKeyEvent& event) {
+    // Mark kitty protocol as confirmed working
+    kitty_confirmed_ = true;
+
+    auto game_key = kitty::toGameKey(event.key.keycode);
+
+    switch (event.key.event_type) {
+        case kitty::EventType::Press:
+        case kitty::EventType::Repeat:
+            keyboard_.handlePress(game_key, event.time);
+            break;
+        case kitty::EventType::Release:
+            keyboard_.handleRelease(game_key, event.time);
+            break;
     }
 
-    // Not a kitty sequence - fall back to regular FTXUI event handling
-    return handleFtxuiEvent(event);
+    active_source_ = ActiveSource::Keyboard;
 }
 
 void InputManager::setKittyMode(bool enabled) {
@@ -66,7 +58,8 @@ void InputManager::endFrame() {
         }
     }
 
-    keyboard_.endFrame();
+    auto now = KeyboardProvider::Clock::now();
+    keyboard_.endFrame(now);
 
     // Poll gamepad
 
@@ -78,7 +71,7 @@ void InputManager::endFrame() {
     if (active_source_ == ActiveSource::Gamepad && gamepad_.isAvailable()) {
         current_ = gamepad_.snapshot();
     } else {
-        current_ = keyboard_.snapshot();
+        current_ = keyboard_.snapshot(now);
     }
 }
 
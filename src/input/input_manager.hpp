@@ -3,6 +3,7 @@
 #include "input/input_action.hpp"
 #include "input/keyboard_provider.hpp"
 #include "input/gamepad_provider.hpp"
+#include "input/input_thread.hpp"
 
 #include <ftxui/component/event.hpp>
 
@@ -13,15 +14,15 @@ public:
     // Called from FTXUI CatchEvent. Returns true if consumed.
     bool handleFtxuiEvent(const ftxui::Event& event);
 
-    // Try to parse the event as a kitty keyboard protocol sequence.
-    // Returns true if the event was a valid kitty sequence and was consumed.
-    // Falls back to handleFtxuiEvent() if not a kitty sequence.
-    bool handleRawEvent(const ftxui::Event& event);
+    // Apply a parsed kitty key event at the time it was read (claimed by
+    // the InputThread, or parsed by the App from an FTXUI event)
+    void handleKeyEvent(const TimedKeyEvent& event);
 
-    // Call once per frame before reading input
+    // Start collecting input for the next step; call right after a step
     void beginFrame();
 
-    // Poll gamepad and finalize frame input
+    // Poll gamepad and finalize frame input; call right before the physics
+    // step so hold durations are measured up to it
     void endFrame();
 
     // Get the current merged input state
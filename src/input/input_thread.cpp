@@ -0,0 +1,177 @@
+#include "input/input_thread.hpp"
+#include "diagnostics/trace.hpp"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace {
+
+void closeFd(int& fd) {
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+}
+
+} // namespace
+
+InputThread::~InputThread() {
+    stop();
+}
+
+bool InputThread::start() {
+    if (running() || !isatty(STDIN_FILENO)) {
+        return false;
+    }
+
+    int forward[2];
+    int wake[2];
+    if (pipe(forward) != 0) {
+        return false;
+    }
+    if (pipe(wake) != 0) {
+        close(forward[0]);
+        close(forward[1]);
+        return false;
+    }
+    forward_read_ = forward[0];
+    forward_write_ = forward[1];
+    wake_read_ = wake[0];
+    wake_write_ = wake[1];
+
+    // Never block on a reader that has stopped draining
+    fcntl(forward_write_, F_SETFL, fcntl(forward_write_, F_GETFL) | O_NONBLOCK);
+
+    tty_fd_ = dup(STDIN_FILENO);
+    if (tty_fd_ < 0 || dup2(forward_read_, STDIN_FILENO) < 0) {
+        closeFd(tty_fd_);
+        closeFd(forward_read_);
+        closeFd(forward_write_);
+        closeFd(wake_read_);
+        closeFd(wake_write_);
+        return false;
+    }
+
+    thread_ = std::thread(&InputThread::readLoop, this);
+    return true;
+}
+
+void InputThread::stop() {
+    if (!running()) {
+        return;
+    }
+
+    char wake = 0;
+    while (write(wake_write_, &wake, 1) < 0 && errno == EINTR) {
+    }
+    thread_.join();
+
+    // Terminal settings live on the device, so fd 0 comes back as it was
+    dup2(tty_fd_, STDIN_FILENO);
+    closeFd(tty_fd_);
+    closeFd(forward_read_);
+    closeFd(forward_write_);
+    closeFd(wake_read_);
+    closeFd(wake_write_);
+    pending_.clear();
+}
+
+void InputThread::readLoop() {
+    TRACE_THREAD_NAME("input");
+    pollfd fds[2] = {
+        {tty_fd_, POLLIN, 0},
+        {wake_read_, POLLIN, 0},
+    };
+    char buffer[256];
+
+    while (true) {
+        // A held-back ESC may be the Escape key rather than a sequence start
+        int timeout = pending_.empty() ? -1 : ESCAPE_TIMEOUT_MS;
+        int ready = poll(fds, 2, timeout);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        if (fds[1].revents != 0) {
+            return;
+        }
+        if (ready == 0) {
+            forward(0, pending_.size());
+            pending_.clear();
+            continue;
+        }
+        if ((fds[0].revents & POLLIN) == 0) {
+            return; // Hung up
+        }
+
+        auto now = Clock::now();
+        ssize_t count = read(tty_fd_, buffer, sizeof(buffer));
+        if (count < 0 && (errno == EINTR || errno == EAGAIN)) {
+            continue;
+        }
+        if (count <= 0) {
+            return;
+        }
+        pending_.append(buffer, static_cast<size_t>(count));
+        process(now);
+    }
+}
+
+void InputThread::process(Clock::time_point now) {
+    const bool capture = capture_.load(std::memory_order_relaxed);
+    const std::string_view data(pending_);
+    size_t unsent = 0; // Start of bytes not yet claimed or forwarded
+    size_t i = 0;
+
+    // One pass over everything read so far; a read may hold several sequences
+    while (i < data.size()) {
+        if (data[i] != '\x1b') {
+            ++i;
+            continue;
+        }
+
+        kitty::Scan scanned = kitty::scan(data.substr(i));
+        if (scanned.kind == kitty::Scan::Kind::Incomplete) {
+            // Keep the partial sequence for the next read
+            forward(unsent, i - unsent);
+            pending_.erase(0, i);
+            return;
+        }
+
+        if (capture && scanned.kind == kitty::Scan::Kind::Key && claim(scanned.event, now)) {
+            forward(unsent, i - unsent);
+            unsent = i + scanned.length;
+        }
+        i += scanned.length;
+    }
+
+    forward(unsent, data.size() - unsent);
+    pending_.clear();
+}
+
+bool InputThread::claim(const kitty::KeyEvent& event, Clock::time_point now) {
+    if (kitty::toGameKey(event.keycode) == kitty::GameKey::Unknown) {
+        return false;
+    }
+    // A full queue falls back to FTXUI, which handles kitty sequences too
+    return events_.push({event, now});
+}
+
+void InputThread::forward(size_t offset, size_t length) {
+    const char* data = pending_.data() + offset;
+    while (length > 0) {
+        ssize_t written = write(forward_write_, data, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return; // Pipe full: FTXUI has stopped reading
+        }
+        data += written;
+        length -= static_cast<size_t>(written);
+    }
+}
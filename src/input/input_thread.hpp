@@ -0,0 +1,74 @@
+#pragma once
+
+#include "input/kitty_keyboard.hpp"
+#include "input/spsc_queue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <thread>
+
+// A kitty key event stamped with the time its bytes were read
+struct TimedKeyEvent {
+    kitty::KeyEvent key{};
+    std::chrono::steady_clock::time_point time{};
+};
+
+// Reads the terminal on its own thread so key events carry the time they
+// arrived instead of the frame that happened to notice them.
+//
+// While running it owns the TTY: fd 0 is swapped for a pipe, and every
+// byte it does not claim is forwarded into that pipe for FTXUI to read as
+// usual. With capture on, kitty sequences for game keys are claimed and
+// pushed onto events() instead.
+class InputThread {
+public:
+    static constexpr size_t QUEUE_CAPACITY = 256;
+    using Queue = SpscQueue<TimedKeyEvent, QUEUE_CAPACITY>;
+
+    InputThread() = default;
+    ~InputThread();
+
+    InputThread(const InputThread&) = delete;
+    InputThread& operator=(const InputThread&) = delete;
+
+    // Take over fd 0. Call after FTXUI has put the terminal in raw mode.
+    // Returns false (and leaves fd 0 alone) if stdin is not a terminal.
+    bool start();
+
+    // Hand fd 0 back to the terminal. Call before FTXUI restores it.
+    void stop();
+
+    bool running() const { return thread_.joinable(); }
+
+    // Claim game-key sequences (gameplay with kitty active)
+    void setCapture(bool enabled) { capture_.store(enabled, std::memory_order_relaxed); }
+
+    // Consumer side: main thread only
+    Queue& events() { return events_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // A held-back ESC or partial sequence is forwarded after this long
+    // without more bytes
+    static constexpr int ESCAPE_TIMEOUT_MS = 20;
+
+    void readLoop();
+    // Split pending_ into sequences, claiming or forwarding each
+    void process(Clock::time_point now);
+    bool claim(const kitty::KeyEvent& event, Clock::time_point now);
+    void forward(size_t offset, size_t length);
+
+    int tty_fd_ = -1;       // The terminal, formerly fd 0
+    int forward_read_ = -1; // Installed as fd 0
+    int forward_write_ = -1;
+    int wake_read_ = -1;    // Written by stop()
+    int wake_write_ = -1;
+
+    std::string pending_;   // Bytes read but not yet claimed or forwarded
+    std::atomic<bool> capture_{false};
+    Queue events_;
+    std::thread thread_;
+};
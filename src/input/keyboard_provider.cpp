@@ -1,84 +1,159 @@
 #include "input/keyboard_provider.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 bool KeyboardProvider::handleEvent(const ftxui::Event& event) {
     had_activity_ = true;
+    auto now = Clock::now();
 
     if (event == ftxui::Event::ArrowLeft) {
-        left_ = true;
-        left_event_this_frame_ = true;
-        left_frames_since_event_ = 0;
+        repeatEvent(LEFT, now);
         return true;
     }
     if (event == ftxui::Event::ArrowRight) {
-        right_ = true;
-        right_event_this_frame_ = true;
-        right_frames_since_event_ = 0;
+        repeatEvent(RIGHT, now);
         return true;
     }
     if (event == ftxui::Event::ArrowUp) {
-        up_ = true;
-        up_event_this_frame_ = true;
-        up_frames_since_event_ = 0;
+        repeatEvent(UP, now);
         return true;
     }
     if (event == ftxui::Event::ArrowDown) {
-        down_ = true;
-        down_event_this_frame_ = true;
-        down_frames_since_event_ = 0;
+        repeatEvent(DOWN, now);
         return true;
     }
     if (event == ftxui::Event::Character(' ')) {
-        jump_ = true;
-        jump_event_this_frame_ = true;
-        jump_frames_since_event_ = 0;
+        repeatEvent(JUMP, now);
         return true;
     }
     if (event == ftxui::Event::Return) {
-        confirm_ = true;
-        confirm_event_this_frame_ = true;
-        confirm_frames_since_event_ = 0;
+        repeatEvent(CONFIRM, now);
         return true;
     }
     if (event == ftxui::Event::Escape) {
-        pause_ = true;
-        pause_event_this_frame_ = true;
-        pause_frames_since_event_ = 0;
-        back_ = true;
-        back_event_this_frame_ = true;
-        back_frames_since_event_ = 0;
+        repeatEvent(PAUSE, now);
+        repeatEvent(BACK, now);
         return true;
     }
 
     return false;
 }
 
-void KeyboardProvider::handlePress(kitty::GameKey key) {
+void KeyboardProvider::handlePress(kitty::GameKey key, Clock::time_point time) {
     had_activity_ = true;
-    setKeyState(key, true);
+    setKeyState(key, true, time);
 }
 
-void KeyboardProvider::handleRelease(kitty::GameKey key) {
+void KeyboardProvider::handleRelease(kitty::GameKey key, Clock::time_point time) {
     had_activity_ = true;
-    setKeyState(key, false);
+    setKeyState(key, false, time);
+}
+
+bool KeyboardProvider::setKey(Key key, bool pressed, Clock::time_point time) {
+    if (pressed == down_[key]) {
+        return false;
+    }
+    if (pressed) {
+        down_at_[key] = time;
+    } else {
+        up_at_[key] = time;
+        if (!prev_down_[key]) {
+            tapped_.set(key); // Pressed and released within one frame
+        }
+    }
+    down_[key] = pressed;
+    return true;
 }
 
-void KeyboardProvider::setKeyState(kitty::GameKey key, bool pressed) {
+void KeyboardProvider::stampEvent(Clock::time_point time, InputPath path) {
+    if (!event_ || time < event_->time) {
+        event_ = InputStamp{time, path};
+    }
+}
+
+void KeyboardProvider::setKeyState(kitty::GameKey key, bool pressed, Clock::time_point time) {
+    bool changed = false;
     switch (key) {
-        case kitty::GameKey::Left:    left_ = pressed; break;
-        case kitty::GameKey::Right:   right_ = pressed; break;
-        case kitty::GameKey::Up:      up_ = pressed; break;
-        case kitty::GameKey::Down:    down_ = pressed; break;
-        case kitty::GameKey::Space:   jump_ = pressed; break;
-        case kitty::GameKey::Enter:
-            confirm_ = pressed;
-            break;
+        case kitty::GameKey::Left:    changed = setKey(LEFT, pressed, time); break;
+        case kitty::GameKey::Right:   changed = setKey(RIGHT, pressed, time); break;
+        case kitty::GameKey::Up:      changed = setKey(UP, pressed, time); break;
+        case kitty::GameKey::Down:    changed = setKey(DOWN, pressed, time); break;
+        case kitty::GameKey::Space:   changed = setKey(JUMP, pressed, time); break;
+        case kitty::GameKey::Enter:   changed = setKey(CONFIRM, pressed, time); break;
         case kitty::GameKey::Escape:
-            pause_ = pressed;
-            back_ = pressed;
+            changed = setKey(PAUSE, pressed, time);
+            changed |= setKey(BACK, pressed, time);
             break;
         case kitty::GameKey::Unknown:
             break;
     }
+    if (changed) {
+        stampEvent(time, InputPath::Kitty);
+    }
+}
+
+void KeyboardProvider::repeatEvent(Key key, Clock::time_point time) {
+    // Gaps can't be told apart one at a time: a human double tap looks like
+    // a short delay. A long gap followed by a much shorter one is the
+    // autorepeat delay and interval; the cadence lasts until a gap is
+    // clearly longer than the interval.
+    Autorepeat& repeat = repeat_[key];
+    float gap = std::chrono::duration<float>(time - last_event_at_[key]).count();
+    auto smooth = [](float& learned, float sample) {
+        learned = learned == 0.0f ? sample : learned + REPEAT_SMOOTHING * (sample - learned);
+    };
+
+    if (gap <= 0.0f || gap >= MAX_REPEAT_GAP) {
+        repeat.pending_gap = 0.0f;
+        repeat.repeating = false;
+    } else if (repeat.repeating && gap < 2.0f * repeat.interval) {
+        smooth(repeat.interval, gap);
+    } else if (!repeat.repeating && repeat.pending_gap > 0.0f &&
+               gap < repeat.pending_gap * INTERVAL_FRACTION) {
+        smooth(repeat.delay, repeat.pending_gap);
+        smooth(repeat.interval, gap);
+        repeat.repeating = true;
+    } else {
+        repeat.pending_gap = gap;
+        repeat.repeating = false;
+    }
+
+    last_event_at_[key] = time;
+
+    // The first repeat of a key already released as a tap: it never went
+    // up. Keep the original press time and report no new press.
+    const float since_press = std::chrono::duration<float>(time - down_at_[key]).count();
+    if (!down_[key] && timed_out_[key] && isFirstRepeat(key, since_press)) {
+        timed_out_.reset(key);
+        resumed_.set(key);
+        down_[key] = true;
+        return;
+    }
+
+    timed_out_.reset(key);
+    if (setKey(key, true, time)) {
+        stampEvent(time, InputPath::Fallback);
+    }
+}
+
+float KeyboardProvider::releaseTimeout(Key key) const {
+    const Autorepeat& repeat = repeat_[key];
+    if (!repeat.repeating || repeat.interval == 0.0f) {
+        return DEFAULT_RELEASE_TIMEOUT;
+    }
+    return std::min(DEFAULT_RELEASE_TIMEOUT,
+                    repeat.interval +
+                        std::max(MIN_RELEASE_MARGIN, repeat.interval * RELEASE_MARGIN_FRACTION));
+}
+
+bool KeyboardProvider::isFirstRepeat(Key key, float since_press) const {
+    const float delay = repeat_[key].delay;
+    if (delay == 0.0f) {
+        return false;
+    }
+    return std::abs(since_press - delay) <=
+           std::max(MIN_RELEASE_MARGIN, delay * RELEASE_MARGIN_FRACTION);
 }
 
 void KeyboardProvider::setKittyMode(bool enabled) {
@@ -87,109 +162,56 @@ void KeyboardProvider::setKittyMode(bool enabled) {
 
 void KeyboardProvider::beginFrame() {
     // Save previous states for edge detection
-    prev_left_ = left_;
-    prev_right_ = right_;
-    prev_up_ = up_;
     prev_down_ = down_;
-    prev_jump_ = jump_;
-    prev_confirm_ = confirm_;
-    prev_back_ = back_;
-    prev_pause_ = pause_;
-
-    // Clear event flags for this frame (only needed for timeout mode)
-    if (!kitty_mode_) {
-        left_event_this_frame_ = false;
-        right_event_this_frame_ = false;
-        up_event_this_frame_ = false;
-        down_event_this_frame_ = false;
-        jump_event_this_frame_ = false;
-        confirm_event_this_frame_ = false;
-        back_event_this_frame_ = false;
-        pause_event_this_frame_ = false;
-    }
-
+    tapped_.reset();
+    resumed_.reset();
+    event_.reset();
     had_activity_ = false;
 }
 
-void KeyboardProvider::endFrame() {
+void KeyboardProvider::endFrame(Clock::time_point now) {
     // In kitty mode, we get real release events - no timeout needed
     if (kitty_mode_) {
         return;
     }
 
-    // Timeout-based release detection: increment frame counters for keys that didn't
-    // receive an event this frame, and clear them after RELEASE_TIMEOUT_FRAMES.
-    // This tolerates the OS key-repeat delay while still detecting releases.
-
-    if (!left_event_this_frame_) {
-        left_frames_since_event_++;
-        if (left_frames_since_event_ >= RELEASE_TIMEOUT_FRAMES) {
-            left_ = false;
-        }
-    }
-
-    if (!right_event_this_frame_) {
-        right_frames_since_event_++;
-        if (right_frames_since_event_ >= RELEASE_TIMEOUT_FRAMES) {
-            right_ = false;
-        }
-    }
-
-    if (!up_event_this_frame_) {
-        up_frames_since_event_++;
-        if (up_frames_since_event_ >= RELEASE_TIMEOUT_FRAMES) {
-            up_ = false;
+    // Release held keys once their next event is overdue. The release is
+    // stamped now, when it shows, so a jump charges for as long as the
+    // ball was seen compressing.
+    for (int i = 0; i < KEY_COUNT; ++i) {
+        auto key = static_cast<Key>(i);
+        if (!down_[key]) {
+            continue;
         }
-    }
-
-    if (!down_event_this_frame_) {
-        down_frames_since_event_++;
-        if (down_frames_since_event_ >= RELEASE_TIMEOUT_FRAMES) {
-            down_ = false;
-        }
-    }
-
-    if (!jump_event_this_frame_) {
-        jump_frames_since_event_++;
-        if (jump_frames_since_event_ >= RELEASE_TIMEOUT_FRAMES) {
-            jump_ = false;
-        }
-    }
-
-    if (!confirm_event_this_frame_) {
-        confirm_frames_since_event_++;
-        if (confirm_frames_since_event_ >= RELEASE_TIMEOUT_FRAMES) {
-            confirm_ = false;
-        }
-    }
-
-    if (!back_event_this_frame_) {
-        back_frames_since_event_++;
-        if (back_frames_since_event_ >= RELEASE_TIMEOUT_FRAMES) {
-            back_ = false;
-        }
-    }
-
-    if (!pause_event_this_frame_) {
-        pause_frames_since_event_++;
-        if (pause_frames_since_event_ >= RELEASE_TIMEOUT_FRAMES) {
-            pause_ = false;
+        float silent = std::chrono::duration<float>(now - last_event_at_[key]).count();
+        if (silent >= releaseTimeout(key)) {
+            if (!repeat_[key].repeating) {
+                timed_out_.set(key);
+            }
+            setKey(key, false, now);
         }
     }
 }
 
-InputSnapshot KeyboardProvider::snapshot() const {
+InputSnapshot KeyboardProvider::snapshot(Clock::time_point now) const {
+    KeyBits changed = down_ ^ prev_down_;
+    KeyBits pressed = (changed & down_ & ~resumed_) | tapped_;
+    KeyBits released = (changed & prev_down_) | tapped_;
+
     InputSnapshot snap;
-    snap.move_left = left_;
-    snap.move_right = right_;
-    snap.move_up = up_;
-    snap.move_down = down_;
-    snap.jump_held = jump_;
-    snap.jump_just_pressed = jump_ && !prev_jump_;
-    snap.jump_just_released = !jump_ && prev_jump_;
-    snap.confirm = confirm_;
-    snap.back = back_;
-    snap.pause = pause_;
-    snap.horizontal_axis = (left_ ? -1.0f : 0.0f) + (right_ ? 1.0f : 0.0f);
+    snap.move_left = down_[LEFT];
+    snap.move_right = down_[RIGHT];
+    snap.move_up = down_[UP];
+    snap.move_down = down_[DOWN];
+    snap.jump_held = down_[JUMP];
+    snap.jump_just_pressed = pressed[JUMP];
+    snap.jump_just_released = released[JUMP];
+    auto held = (down_[JUMP] ? now : up_at_[JUMP]) - down_at_[JUMP];
+    snap.jump_held_seconds = std::max(0.0f, std::chrono::duration<float>(held).count());
+    snap.confirm = down_[CONFIRM];
+    snap.back = down_[BACK];
+    snap.pause = down_[PAUSE];
+    snap.horizontal_axis = (down_[LEFT] ? -1.0f : 0.0f) + (down_[RIGHT] ? 1.0f : 0.0f);
+    snap.event = event_;
     return snap;
 }
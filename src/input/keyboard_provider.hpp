@@ -5,25 +5,36 @@
 
 #include <ftxui/component/event.hpp>
 
+#include <array>
+#include <bitset>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
 class KeyboardProvider {
 public:
+    using Clock = std::chrono::steady_clock;
+
     // Process an FTXUI event. Returns true if the event was consumed.
     // Used when kitty protocol is not active (menu states).
     bool handleEvent(const ftxui::Event& event);
 
-    // Process a kitty keyboard press event. Sets key state immediately.
-    void handlePress(kitty::GameKey key);
+    // Process a kitty keyboard press event. Sets key state immediately;
+    // time is when the event was read.
+    void handlePress(kitty::GameKey key, Clock::time_point time = Clock::now());
 
     // Process a kitty keyboard release event. Clears key state immediately.
-    void handleRelease(kitty::GameKey key);
+    void handleRelease(kitty::GameKey key, Clock::time_point time = Clock::now());
 
     // Call once per frame before reading snapshot to detect releases.
     void beginFrame();
 
-    // Call once per frame after processing all events.
-    void endFrame();
+    // Call once per frame after processing all events; releases keys whose
+    // autorepeat has stopped (non-kitty mode).
+    void endFrame(Clock::time_point now);
 
-    InputSnapshot snapshot() const;
+    // Key state as of now (for the jump hold duration)
+    InputSnapshot snapshot(Clock::time_point now) const;
     bool hadActivity() const { return had_activity_; }
 
     // Enable/disable kitty mode. When enabled, timeout-based release
@@ -32,54 +43,59 @@ public:
     bool kittyMode() const { return kitty_mode_; }
 
 private:
-    // Set or clear the boolean for a given game key
-    void setKeyState(kitty::GameKey key, bool pressed);
+    enum Key : uint8_t { LEFT, RIGHT, UP, DOWN, JUMP, CONFIRM, BACK, PAUSE, KEY_COUNT };
+    using KeyBits = std::bitset<KEY_COUNT>;
+
+    // Without release events a key is held for as long as autorepeat keeps
+    // sending it. Per key we learn the delay before the first repeat and
+    // the interval between repeats from event gaps. Once repeating, a key
+    // is released when its next repeat is overdue. Before that, a tap is
+    // released after the old fixed timeout rather than the (much longer)
+    // delay; if the first repeat then arrives, the key was held after all
+    // and resumes its hold without a second press.
+    struct Autorepeat {
+        float pending_gap = 0.0f; // Last gap not yet known to be a delay
+        bool repeating = false;   // Currently in the fast repeat cadence
+        float delay = 0.0f;       // Learned seconds, 0 until observed
+        float interval = 0.0f;
+    };
+
+    // Returns true if the key changed state
+    bool setKey(Key key, bool pressed, Clock::time_point time);
+    void stampEvent(Clock::time_point time, InputPath path);
+    void setKeyState(kitty::GameKey key, bool pressed, Clock::time_point time);
+    // An FTXUI press or autorepeat (non-kitty mode)
+    void repeatEvent(Key key, Clock::time_point time);
+    float releaseTimeout(Key key) const;
+    // An event this long after the press lands on the learned delay, so is
+    // the first autorepeat rather than a second tap
+    bool isFirstRepeat(Key key, float since_press) const;
 
     bool kitty_mode_ = false;
 
-    // Current frame key states (persistent until release detected)
-    bool left_ = false;
-    bool right_ = false;
-    bool up_ = false;
-    bool down_ = false;
-    bool jump_ = false;
-    bool confirm_ = false;
-    bool back_ = false;
-    bool pause_ = false;
-
-    // Previous frame state for edge detection
-    bool prev_left_ = false;
-    bool prev_right_ = false;
-    bool prev_up_ = false;
-    bool prev_down_ = false;
-    bool prev_jump_ = false;
-    bool prev_confirm_ = false;
-    bool prev_back_ = false;
-    bool prev_pause_ = false;
-
-    // Track if key received event this frame (for release detection)
-    bool left_event_this_frame_ = false;
-    bool right_event_this_frame_ = false;
-    bool up_event_this_frame_ = false;
-    bool down_event_this_frame_ = false;
-    bool jump_event_this_frame_ = false;
-    bool confirm_event_this_frame_ = false;
-    bool back_event_this_frame_ = false;
-    bool pause_event_this_frame_ = false;
-
-    // Frame counters since last event (for timeout-based release detection)
-    int left_frames_since_event_ = 0;
-    int right_frames_since_event_ = 0;
-    int up_frames_since_event_ = 0;
-    int down_frames_since_event_ = 0;
-    int jump_frames_since_event_ = 0;
-    int confirm_frames_since_event_ = 0;
-    int back_frames_since_event_ = 0;
-    int pause_frames_since_event_ = 0;
-
-    // Release timeout: clear key after this many frames without an event
-    // At 60 FPS, 10 frames = ~166ms (tolerates OS key-repeat delay)
-    static constexpr int RELEASE_TIMEOUT_FRAMES = 10;
+    KeyBits down_;       // Held now
+    KeyBits prev_down_;  // Held at beginFrame(); XOR gives this frame's edges
+    KeyBits tapped_;     // Went down and up again since beginFrame()
+    KeyBits timed_out_;  // Released by timeout before its first repeat
+    KeyBits resumed_;    // Held again by that repeat since beginFrame()
+
+    std::array<Clock::time_point, KEY_COUNT> down_at_{};
+    std::array<Clock::time_point, KEY_COUNT> up_at_{};
+    std::array<Clock::time_point, KEY_COUNT> last_event_at_{}; // Press or autorepeat
+    std::array<Autorepeat, KEY_COUNT> repeat_{};
+    std::optional<InputStamp> event_; // First state change this frame
+
+    // Before repeats start (and the cap on taps): the old fixed timeout of
+    // 10 frames at 60 FPS
+    static constexpr float DEFAULT_RELEASE_TIMEOUT = 0.166f;
+    // Slack over the learned timing; events reach us once per frame, so
+    // gaps are only accurate to about a frame
+    static constexpr float MIN_RELEASE_MARGIN = 0.025f;
+    static constexpr float RELEASE_MARGIN_FRACTION = 0.25f;
+    static constexpr float REPEAT_SMOOTHING = 0.25f;
+    static constexpr float MAX_REPEAT_GAP = 1.0f;  // Longer gaps start a new press
+    // A wait followed by a gap this much shorter was a delay then an interval
+    static constexpr float INTERVAL_FRACTION = 0.6f;
 
     bool had_activity_ = false;
 };
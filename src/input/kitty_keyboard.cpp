@@ -1,7 +1,6 @@
 #include "input/kitty_keyboard.hpp"
 
 #include <cstdio>
-#include <vector>
 
 namespace kitty {
 
@@ -17,138 +16,125 @@ void disable() {
     std::fflush(stdout);
 }
 
-// Parse a semicolon/colon-separated parameter field from a CSI sequence.
-// Returns the numeric values split by ':' sub-parameters within a single
-// ';'-separated field.
+namespace {
+
+// One ';'-separated CSI parameter field; only the first ':' sub-parameter
+// is kept (the event type, in the modifiers field)
 struct CsiParam {
-    uint32_t value = 0;       // Main parameter value
-    uint32_t sub_value = 0;   // Sub-parameter after ':'
-    bool has_sub = false;
+    uint32_t value = 0;
+    uint32_t sub_value = 0;
+    uint8_t sub_count = 0;
 };
 
-static auto parseCsiParams(const std::string& raw, size_t start, size_t end)
-    -> std::vector<CsiParam> {
-    std::vector<CsiParam> params;
-    CsiParam current;
-    bool in_sub = false;
+// keycode, modifiers[:event_type], text; later fields are skipped
+constexpr size_t MAX_PARAMS = 3;
 
-    for (size_t i = start; i < end; ++i) {
-        char c = raw[i];
-        if (c >= '0' && c <= '9') {
-            uint32_t digit = static_cast<uint32_t>(c - '0');
-            if (in_sub) {
-                current.sub_value = current.sub_value * 10 + digit;
-            } else {
-                current.value = current.value * 10 + digit;
-            }
-        } else if (c == ':') {
-            current.has_sub = true;
-            in_sub = true;
-        } else if (c == ';') {
-            params.push_back(current);
-            current = {};
-            in_sub = false;
-        }
+auto functionalKeycode(char terminator) -> uint32_t {
+    switch (terminator) {
+        case 'A': return 57417;  // Up
+        case 'B': return 57420;  // Down
+        case 'C': return 57421;  // Right (note: spec uses this)
+        case 'D': return 57419;  // Left
+        case 'H': return 57423;  // Home
+        case 'F': return 57424;  // End
+        case 'P': return 57364;  // F1
+        case 'Q': return 57365;  // F2
+        case 'R': return 57366;  // F3
+        case 'S': return 57367;  // F4
+        default:  return 0;
     }
-    params.push_back(current);
-    return params;
 }
 
-auto parse(const std::string& raw) -> std::optional<KeyEvent> {
-    // Minimum valid kitty sequence: ESC [ digit u = 4 bytes
-    if (raw.size() < 4) {
-        return std::nullopt;
-    }
-
-    // Must start with CSI (ESC [)
-    if (raw[0] != '\x1b' || raw[1] != '[') {
-        return std::nullopt;
-    }
-
-    // Find the terminating byte (last character)
-    char terminator = raw.back();
-
-    // Determine if this is a CSI u sequence or a functional key sequence
-    bool is_csi_u = (terminator == 'u');
-    bool is_functional = (terminator >= 'A' && terminator <= 'H') ||
-                         (terminator >= 'P' && terminator <= 'S');
+}  // namespace
 
-    if (!is_csi_u && !is_functional) {
-        return std::nullopt;
+auto scan(std::string_view input) -> Scan {
+    Scan result;
+    if (input.empty() || (input[0] == '\x1b' && input.size() < 2)) {
+        return result;
     }
-
-    // Parse the parameter bytes between CSI and the terminator
-    auto params = parseCsiParams(raw, 2, raw.size() - 1);
-
-    if (params.empty()) {
-        return std::nullopt;
+    if (input[0] != '\x1b' || input[1] != '[') {
+        result.kind = Scan::Kind::NotCsi;
+        result.length = 1;
+        return result;
     }
 
-    KeyEvent event;
-
-    if (is_csi_u) {
-        // CSI keycode [; modifiers[:event_type] [; text_codepoints]] u
-        event.keycode = params[0].value;
+    CsiParam params[MAX_PARAMS];
+    size_t field = 0;
+    bool in_sub = false;
+    bool private_bytes = false;  // Replies like CSI ? flags u are not keys
 
-        if (params.size() >= 2) {
-            // Modifiers are encoded as 1 + actual_modifiers
-            uint32_t mod_field = params[1].value;
-            event.modifiers = (mod_field > 0) ? static_cast<uint8_t>(mod_field - 1) : 0;
+    for (size_t i = 2; i < input.size(); ++i) {
+        auto c = static_cast<unsigned char>(input[i]);
 
-            // Event type is a sub-parameter of the modifiers field
-            if (params[1].has_sub) {
-                uint8_t et = static_cast<uint8_t>(params[1].sub_value);
-                if (et >= 1 && et <= 3) {
-                    event.event_type = static_cast<EventType>(et);
-                } else {
-                    event.event_type = EventType::Press;
+        if (c >= '0' && c <= '9') {
+            if (field < MAX_PARAMS) {
+                CsiParam& param = params[field];
+                uint32_t digit = c - '0';
+                if (!in_sub) {
+                    param.value = param.value * 10 + digit;
+                } else if (param.sub_count == 1) {
+                    param.sub_value = param.sub_value * 10 + digit;
                 }
-            } else {
-                event.event_type = EventType::Press;
             }
-        } else {
+        } else if (c == ':') {
+            if (field < MAX_PARAMS && params[field].sub_count < 2) {
+                params[field].sub_count++;
+            }
+            in_sub = true;
+        } else if (c == ';') {
+            ++field;
+            in_sub = false;
+        } else if (c >= 0x20 && c <= 0x3F) {
+            // Private markers and intermediates: part of the sequence, not a key field
+            private_bytes = true;
+        } else if (c >= 0x40 && c <= 0x7E) {
+            // Final byte
+            result.length = i + 1;
+            char terminator = static_cast<char>(c);
+            bool is_csi_u = (terminator == 'u');
+            bool is_functional = (terminator >= 'A' && terminator <= 'H') ||
+                                 (terminator >= 'P' && terminator <= 'S');
+            if ((!is_csi_u && !is_functional) || private_bytes) {
+                result.kind = Scan::Kind::Other;
+                return result;
+            }
+
+            // CSI keycode [; modifiers[:event_type] [; text_codepoints]] u
+            // or CSI 1 ; modifiers[:event_type] [ABCDEFHPQS]
+            KeyEvent& event = result.event;
+            event.keycode = is_csi_u ? params[0].value : functionalKeycode(terminator);
             event.modifiers = 0;
             event.event_type = EventType::Press;
-        }
-    } else {
-        // Functional key form: CSI 1 ; modifiers[:event_type] [ABCDEFHPQS]
-        // The first parameter is typically 1 for functional keys
-        // Map terminator to keycode
-        switch (terminator) {
-            case 'A': event.keycode = 57417; break;  // Up
-            case 'B': event.keycode = 57420; break;  // Down
-            case 'C': event.keycode = 57421; break;  // Right (note: spec uses this)
-            case 'D': event.keycode = 57419; break;  // Left
-            case 'H': event.keycode = 57423; break;  // Home
-            case 'F': event.keycode = 57424; break;  // End
-            case 'P': event.keycode = 57364; break;  // F1
-            case 'Q': event.keycode = 57365; break;  // F2
-            case 'R': event.keycode = 57366; break;  // F3
-            case 'S': event.keycode = 57367; break;  // F4
-            default:  event.keycode = 0; break;
-        }
-
-        if (params.size() >= 2) {
-            uint32_t mod_field = params[1].value;
-            event.modifiers = (mod_field > 0) ? static_cast<uint8_t>(mod_field - 1) : 0;
-
-            if (params[1].has_sub) {
-                uint8_t et = static_cast<uint8_t>(params[1].sub_value);
-                if (et >= 1 && et <= 3) {
+            if (field >= 1) {
+                // Modifiers are encoded as 1 + actual_modifiers
+                uint32_t mod_field = params[1].value;
+                event.modifiers = (mod_field > 0) ? static_cast<uint8_t>(mod_field - 1) : 0;
+
+                // Event type is a sub-parameter of the modifiers field
+                uint32_t et = params[1].sub_value;
+                if (params[1].sub_count > 0 && et >= 1 && et <= 3) {
                     event.event_type = static_cast<EventType>(et);
-                } else {
-                    event.event_type = EventType::Press;
                 }
-            } else {
-                event.event_type = EventType::Press;
             }
+            result.kind = Scan::Kind::Key;
+            return result;
         } else {
-            event.modifiers = 0;
-            event.event_type = EventType::Press;
+            // Control byte inside the sequence: not CSI after all
+            result.kind = Scan::Kind::NotCsi;
+            result.length = 1;
+            return result;
         }
     }
 
-    return event;
+    return result;  // Incomplete
+}
+
+auto parse(std::string_view input) -> std::optional<KeyEvent> {
+    Scan scanned = scan(input);
+    if (scanned.kind != Scan::Kind::Key || scanned.length != input.size()) {
+        return std::nullopt;
+    }
+    return scanned.event;
 }
 
 auto toGameKey(uint32_t keycode) -> GameKey {
@@ -1,8 +1,9 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <optional>
-#include <string>
+#include <string_view>
 
 namespace kitty {
 
@@ -38,10 +39,48 @@ void enable(int flags = 0b11);
 // Writes the escape sequence to stdout.
 void disable();
 
-// Parse raw terminal input bytes (from FTXUI event.input()) as a kitty keyboard
-// protocol sequence. Returns nullopt if the input is not a valid kitty sequence.
-// Handles both CSI u form and functional key form (CSI 1;... [ABCDEFHPQS]).
-auto parse(const std::string& raw) -> std::optional<KeyEvent>;
+// One escape sequence scanned from the front of a buffer
+struct Scan {
+    enum class Kind : uint8_t {
+        Key,        // Kitty key event (CSI u or functional form), in event
+        Other,      // Any other complete CSI sequence
+        NotCsi,     // A byte that does not start a CSI sequence (length 1)
+        Incomplete, // The buffer ends inside the sequence
+    };
+
+    Kind kind = Kind::Incomplete;
+    size_t length = 0; // Bytes spanned; 0 when Incomplete
+    KeyEvent event{};
+};
+
+// Scan the sequence at the start of input in a single pass, with fixed
+// storage for the parameters. Never allocates.
+auto scan(std::string_view input) -> Scan;
+
+// Parse input as exactly one kitty keyboard protocol sequence. Returns
+// nullopt if it is anything else. Handles both CSI u form and functional
+// key form (CSI 1;... [ABCDEFHPQS]).
+auto parse(std::string_view input) -> std::optional<KeyEvent>;
+
+// Call fn(const KeyEvent&) for each kitty key sequence in input, which may
+// hold several back to back (one read, or one FTXUI event). Other bytes
+// are skipped. Returns the number of key events.
+template <typename Fn>
+int forEachKey(std::string_view input, Fn&& fn) {
+    int count = 0;
+    while (!input.empty()) {
+        Scan scanned = scan(input);
+        if (scanned.kind == Scan::Kind::Incomplete) {
+            break;
+        }
+        if (scanned.kind == Scan::Kind::Key) {
+            fn(scanned.event);
+            ++count;
+        }
+        input.remove_prefix(scanned.length);
+    }
+    return count;
+}
 
 // Map a kitty protocol keycode to a game-relevant key action.
 auto toGameKey(uint32_t keycode) -> GameKey;
@@ -2,10 +2,29 @@
 #include "level/cubic_spline.hpp"
 #include "debug_log.hpp"
 
+#include <cctype>
 #include <cmath>
 #include <algorithm>
-#include <sstream>
-#include <iomanip>
+#include <string_view>
+#include <utility>
+
+namespace {
+
+// Distance of p from the chord prev -> next; how much dropping p flattens
+// the line
+float chordDistance(b2Vec2 prev, b2Vec2 p, b2Vec2 next) {
+    const float cx = next.x - prev.x;
+    const float cy = next.y - prev.y;
+    const float dx = p.x - prev.x;
+    const float dy = p.y - prev.y;
+    const float length = std::sqrt(cx * cx + cy * cy);
+    if (length <= 0.0f) {
+        return std::sqrt(dx * dx + dy * dy);
+    }
+    return std::fabs(cx * dy - cy * dx) / length;
+}
+
+} // namespace
 
 LevelGenerator::LevelGenerator(StdinReader& reader)
     : reader_(reader),
@@ -43,23 +62,23 @@ LevelSegment LevelGenerator::generateSegmentFromText(const std::string& line) {
     // Use the line directly as display text (no word splitting)
     segment.display_text = line.empty() ? " " : line;
 
-    // Each display character = 0.15 world units (matches text bar character width)
-    constexpr float chars_to_world = 0.15f;
+    constexpr float chars_to_world = LevelSegment::CHAR_WORLD_WIDTH;
     constexpr int sample_interval = 5; // Sample every 5th character
 
     float segment_width = static_cast<float>(segment.display_text.length()) * chars_to_world;
     segment.end_x = current_x_ + segment_width;
+    indexWords(segment);
 
     // Initialize state for this segment
     if (segments_generated_ == 0) {
         current_y_ = 0.0f;
         smoothed_y_ = 0.0f;
-        DEBUG_LOG("  [FIRST SEGMENT] Initializing: current_y=0, smoothed_y=0");
+        LOG_DEBUG("segment.first", "current_y", current_y_, "smoothed_y", smoothed_y_);
     } else {
         current_y_ = last_segment_end_y_;
         smoothed_y_ += Y_SMOOTHING_FACTOR * (last_segment_end_y_ - smoothed_y_);
-        DEBUG_LOG("  [CONTINUATION] Pinning to previous: current_y=", std::fixed, std::setprecision(3),
-                  current_y_, " (from last_segment_end_y_)");
+        // Pinned to the previous segment's end
+        LOG_DEBUG("segment.continue", "current_y", current_y_, "smoothed_y", smoothed_y_);
     }
 
     // Generate control points by sampling every Nth character
@@ -121,11 +140,13 @@ LevelSegment LevelGenerator::generateSegmentFromText(const std::string& line) {
     }
 
     // Sample the spline
-    segment.sampled_points = CubicSpline::interpolate(segment.spline_points, 0.25f);
+    segment.sampled_points = CubicSpline::interpolate(segment.spline_points,
+                                                      LevelSegment::SAMPLE_SPACING);
 
     // CRITICAL: Reverse points for correct chain winding (right-to-left)
     // Box2D chains need CCW winding for upward-facing normals
     std::reverse(segment.sampled_points.begin(), segment.sampled_points.end());
+    buildLod(segment);
 
     // Record the segment endpoint X and Y for next segment continuity
     // (after reversal, back() is the leftmost point, front() is the rightmost)
@@ -134,22 +155,20 @@ LevelSegment LevelGenerator::generateSegmentFromText(const std::string& line) {
         last_segment_end_y_ = segment.sampled_points.front().y;
     }
 
-    // Debug logging for segment boundaries
+    // Segment boundaries (the rightmost point is the captured endpoint)
     if (!segment.sampled_points.empty()) {
-        DEBUG_LOG("Segment #", segments_generated_, " '", segment.display_text.substr(0, 20),
-                  (segment.display_text.length() > 20 ? "..." : ""), "'");
-        DEBUG_LOG("  start_x=", std::fixed, std::setprecision(3), segment.start_x,
-                  " end_x=", segment.end_x);
-        DEBUG_LOG("  First sampled point (rightmost): (",
-                  segment.sampled_points.front().x, ", ",
-                  segment.sampled_points.front().y, ")");
-        DEBUG_LOG("  Last sampled point (leftmost): (",
-                  segment.sampled_points.back().x, ", ",
-                  segment.sampled_points.back().y, ")");
-        DEBUG_LOG("  Total sampled points: ", segment.sampled_points.size());
-        DEBUG_LOG("  Captured endpoint: (", last_segment_end_x_, ", ", last_segment_end_y_, ")");
-        DEBUG_LOG("  macro_freq=", std::setprecision(5), macro_frequency,
-                  " slope_at_end=", std::setprecision(3), -DOWNWARD_SLOPE * segment.end_x);
+        LOG_DEBUG("segment.generated",
+                  "index", segments_generated_,
+                  "text", std::string_view(segment.display_text).substr(0, 20),
+                  "start_x", segment.start_x,
+                  "end_x", segment.end_x,
+                  "right_x", segment.sampled_points.front().x,
+                  "right_y", segment.sampled_points.front().y,
+                  "left_x", segment.sampled_points.back().x,
+                  "left_y", segment.sampled_points.back().y,
+                  "points", segment.sampled_points.size(),
+                  "macro_freq", macro_frequency,
+                  "slope_at_end", -DOWNWARD_SLOPE * segment.end_x);
     }
 
     // No gap between segments — continuous terrain
@@ -162,6 +181,63 @@ LevelSegment LevelGenerator::generateSegmentFromText(const std::string& line) {
     return segment;
 }
 
+void LevelGenerator::indexWords(LevelSegment& segment) {
+    // Locate words once so the text bar never re-tokenizes per frame
+    const std::string& text = segment.display_text;
+    size_t i = 0;
+    while (i < text.size()) {
+        if (std::isspace(static_cast<unsigned char>(text[i]))) {
+            ++i;
+            continue;
+        }
+        size_t start = i;
+        while (i < text.size() && !std::isspace(static_cast<unsigned char>(text[i]))) {
+            ++i;
+        }
+        segment.words.push_back({static_cast<uint32_t>(start),
+                                 static_cast<uint32_t>(i - start),
+                                 segment.start_x + start * LevelSegment::CHAR_WORLD_WIDTH});
+    }
+}
+
+void LevelGenerator::buildLod(LevelSegment& segment) {
+    // Roughly halve the samples per level until a level is a single line.
+    // Interior points are taken in pairs (a trailing odd one joins the last
+    // pair) and only the one sticking out furthest from its neighbours is
+    // kept, so narrow peaks and dips survive every level instead of
+    // depending on which indices a stride keeps. Both ends are always kept
+    // so neighbouring segments stay joined.
+    segment.lod_points.reserve(LevelSegment::MAX_LOD_LEVELS);
+    const std::vector<b2Vec2>* finer = &segment.sampled_points;
+    while (finer->size() > 2 &&
+           static_cast<int>(segment.lod_points.size()) < LevelSegment::MAX_LOD_LEVELS) {
+        const std::vector<b2Vec2>& f = *finer;
+        const size_t last = f.size() - 1;
+        std::vector<b2Vec2> coarser;
+        coarser.reserve(f.size() / 2 + 2);
+        coarser.push_back(f.front());
+        for (size_t i = 1; i + 1 < last; i += 2) {
+            const size_t end = (i + 3 == last) ? i + 3 : i + 2; // Pair or final triple
+            size_t best = i;
+            float best_distance = -1.0f;
+            for (size_t j = i; j < end; ++j) {
+                const float distance = chordDistance(f[j - 1], f[j], f[j + 1]);
+                if (distance > best_distance) {
+                    best_distance = distance;
+                    best = j;
+                }
+            }
+            coarser.push_back(f[best]);
+            if (end == i + 3) {
+                break;
+            }
+        }
+        coarser.push_back(f.back());
+        segment.lod_points.push_back(std::move(coarser));
+        finer = &segment.lod_points.back();
+    }
+}
+
 LevelSegment LevelGenerator::generateGoalSegment() {
     LevelSegment segment;
     segment.source_text = "GOAL";
@@ -175,10 +251,12 @@ LevelSegment LevelGenerator::generateGoalSegment() {
         {segment.start_x, last_segment_end_y_},
         {segment.end_x, last_segment_end_y_}
     };
-    segment.sampled_points = CubicSpline::interpolate(segment.spline_points, 0.25f);
+    segment.sampled_points = CubicSpline::interpolate(segment.spline_points,
+                                                      LevelSegment::SAMPLE_SPACING);
 
     // Reverse for correct chain winding
     std::reverse(segment.sampled_points.begin(), segment.sampled_points.end());
+    buildLod(segment);
 
     return segment;
 }
@@ -43,5 +43,7 @@ private:
 
     LevelSegment generateSegmentFromText(const std::string& line);
     LevelSegment generateGoalSegment();
+    static void indexWords(LevelSegment& segment);
+    static void buildLod(LevelSegment& segment);
 };
 
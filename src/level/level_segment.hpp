@@ -2,16 +2,43 @@
 
 #include <box2d/box2d.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <string>
 #include <vector>
 
 struct LevelSegment {
+    // World width of one display_text character (terrain and text bar)
+    static constexpr float CHAR_WORLD_WIDTH = 0.15f;
+    // World X spacing of sampled_points
+    static constexpr float SAMPLE_SPACING = 0.25f;
+    static constexpr int MAX_LOD_LEVELS = 8;
+
+    // A run of non-space characters in display_text
+    struct Word {
+        uint32_t offset;   // First character in display_text
+        uint32_t length;
+        float world_x;     // World X of the first character
+    };
+
     std::string source_text;           // Original text for terrain generation
     std::string display_text;          // Text with 6-space word gaps (for text bar)
     std::vector<b2Vec2> spline_points; // Cubic spline control points
     std::vector<b2Vec2> sampled_points; // Densely sampled spline output
+    // LOD pyramid: each level keeps both ends and the most prominent point
+    // of each pair of the level below (see LevelGenerator::buildLod)
+    std::vector<std::vector<b2Vec2>> lod_points;
+    std::vector<Word> words;           // display_text words, left to right
     float start_x = 0.0f;
     float end_x = 0.0f;
     float gap_after = 0.0f;            // Width of gap after this segment
     bool is_goal = false;              // Final segment with goal posts
+
+    // Polyline at LOD level (0 = sampled_points), clamped to the coarsest
+    const std::vector<b2Vec2>& pointsAtLevel(int level) const {
+        if (level <= 0 || lod_points.empty()) {
+            return sampled_points;
+        }
+        return lod_points[std::min<size_t>(level, lod_points.size()) - 1];
+    }
 };
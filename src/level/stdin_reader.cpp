@@ -1,5 +1,7 @@
 #include "level/stdin_reader.hpp"
 #include "config.hpp"
+#include "diagnostics/memory_tags.hpp"
+#include "diagnostics/trace.hpp"
 
 #include <iostream>
 #include <fstream>
@@ -31,6 +33,10 @@ void StdinReader::stop() {
 }
 
 void StdinReader::readerLoop() {
+    TRACE_THREAD_NAME("stdin reader");
+    TRACE_SCOPE("read level text");
+    MEMORY_SCOPE(Reader);
+
     if (is_pipe_) {
         // Read from STDIN pipe
         std::string line;
@@ -38,6 +44,8 @@ void StdinReader::readerLoop() {
             std::lock_guard<std::mutex> lock(mutex_);
             line_cache_.push_back(line);
             line_buffer_.push(line);
+            memory::setUnits(MemoryTag::Reader, static_cast<int64_t>(line_cache_.size()));
+            TRACE_COUNTER("stdin queue", static_cast<int64_t>(line_cache_.size() - read_position_));
         }
     } else {
         // Load lorem ipsum fallback
@@ -48,6 +56,8 @@ void StdinReader::readerLoop() {
                 std::lock_guard<std::mutex> lock(mutex_);
                 line_cache_.push_back(line);
                 line_buffer_.push(line);
+                memory::setUnits(MemoryTag::Reader, static_cast<int64_t>(line_cache_.size()));
+                TRACE_COUNTER("stdin queue", static_cast<int64_t>(line_cache_.size() - read_position_));
             }
             file.close();
         }
@@ -61,6 +71,7 @@ std::optional<std::string> StdinReader::popNextLine() {
 
     // If we have cached lines and haven't reached the end, return from cache
     if (read_position_ < line_cache_.size()) {
+        TRACE_COUNTER("stdin queue", static_cast<int64_t>(line_cache_.size() - read_position_ - 1));
         return line_cache_[read_position_++];
     }
 
@@ -1,14 +1,100 @@
 #include "app.hpp"
+#include "bench/alloc_check.hpp"
+#include "bench/kitty_bench.hpp"
+#include "bench/output_bench.hpp"
+#include "bench/raster_bench.hpp"
+#include "bench/render_bench.hpp"
+#include "diagnostics/memory_tags.hpp"
+#include "diagnostics/profiler.hpp"
+#include "diagnostics/trace.hpp"
 #include "level/stdin_reader.hpp"
+#include "terminal/reactor.hpp"
 
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
 
-int main() {
+namespace {
+
+constexpr char DEFAULT_TRACE_PATH[] = "masquerade_trace.json";
+
+} // namespace
+
+int main(int argc, char** argv) {
+    // masquerade_ball --bench-raster [cols rows [max_threads]]
+    if (argc > 1 && std::strcmp(argv[1], "--bench-raster") == 0) {
+        int cols = argc > 3 ? std::atoi(argv[2]) : 400;
+        int rows = argc > 3 ? std::atoi(argv[3]) : 120;
+        int max_threads = argc > 4 ? std::atoi(argv[4]) : 0;
+        return runRasterBench(cols, rows, 300, max_threads);
+    }
+
+    // masquerade_ball --bench-output [cols rows]
+    if (argc > 1 && std::strcmp(argv[1], "--bench-output") == 0) {
+        int cols = argc > 3 ? std::atoi(argv[2]) : 200;
+        int rows = argc > 3 ? std::atoi(argv[3]) : 60;
+        return runOutputBench(cols, rows, 300);
+    }
+
+    // masquerade_ball --bench-render [cols rows [frames]] < text
+    if (argc > 1 && std::strcmp(argv[1], "--bench-render") == 0) {
+        int cols = argc > 3 ? std::atoi(argv[2]) : 200;
+        int rows = argc > 3 ? std::atoi(argv[3]) : 60;
+        int frames = argc > 4 ? std::atoi(argv[4]) : 600;
+        return runRenderBench(cols, rows, frames);
+    }
+
+    // masquerade_ball --bench-alloc [cols rows]
+    if (argc > 1 && std::strcmp(argv[1], "--bench-alloc") == 0) {
+        int cols = argc > 3 ? std::atoi(argv[2]) : 200;
+        int rows = argc > 3 ? std::atoi(argv[3]) : 60;
+        return runAllocCheck(cols, rows, 600);
+    }
+
+    // masquerade_ball --bench-kitty [megabytes]
+    if (argc > 1 && std::strcmp(argv[1], "--bench-kitty") == 0) {
+        size_t megabytes = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 8;
+        return runKittyBench(megabytes);
+    }
+
+    // masquerade_ball [--stats] [--trace[=file]]
+    //   --stats: print frame profile timings and memory by subsystem on exit
+    //   --trace: record a Chrome trace (also MASQUERADE_TRACE=file)
+    bool print_stats = false;
+    const char* trace_path = std::getenv("MASQUERADE_TRACE");
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--stats") == 0) {
+            print_stats = true;
+        } else if (std::strcmp(argv[i], "--trace") == 0) {
+            trace_path = DEFAULT_TRACE_PATH;
+        } else if (std::strncmp(argv[i], "--trace=", 8) == 0) {
+            trace_path = argv[i] + 8;
+        }
+    }
+    if (trace_path && *trace_path && !trace::start(trace_path)) {
+        std::fprintf(stderr, "Tracing is not compiled in (configure with -DENABLE_TRACING=ON)\n");
+        return 1;
+    }
+    TRACE_THREAD_NAME("main");
+
+    // Before any thread starts, so resize and quit signals reach the main loop
+    Reactor::blockSignals();
+
     auto stdin_reader = std::make_unique<StdinReader>();
     stdin_reader->start();
 
-    App app(std::move(stdin_reader));
-    app.run();
+    {
+        App app(std::move(stdin_reader));
+        app.run();
+    }
+
+    // After the terminal has been restored and the traced threads joined
+    trace::stop();
+    if (print_stats) {
+        Profiler::instance().printSummary(stdout);
+        memory::printSummary(stdout);
+    }
 
     return 0;
 }
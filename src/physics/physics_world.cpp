@@ -1,6 +1,32 @@
 #include "physics/physics_world.hpp"
+#include "diagnostics/memory_tags.hpp"
+#include "diagnostics/profiler.hpp"
+#include "diagnostics/trace.hpp"
+
+#include <chrono>
+
+namespace {
+
+Profiler::Clock::duration fromMs(float ms) {
+    return std::chrono::duration_cast<Profiler::Clock::duration>(
+        std::chrono::duration<float, std::milli>(ms));
+}
+
+void* box2dAlloc(unsigned int size, int alignment) {
+    return memory::allocate(size, static_cast<std::size_t>(alignment), MemoryTag::Box2D);
+}
+
+void box2dFree(void* mem) {
+    memory::release(mem);
+}
+
+} // namespace
 
 PhysicsWorld::PhysicsWorld() {
+    // Before Box2D allocates anything, so every block is charged to it
+    static const bool allocator_installed = (b2SetAllocator(box2dAlloc, box2dFree), true);
+    (void)allocator_installed;
+
     b2WorldDef world_def = b2DefaultWorldDef();
     world_def.gravity = {0.0f, GRAVITY};
     world_id_ = b2CreateWorld(&world_def);
@@ -13,5 +39,34 @@ PhysicsWorld::~PhysicsWorld() {
 }
 
 void PhysicsWorld::step(float dt) {
-    b2World_Step(world_id_, dt, SUB_STEPS);
+    {
+        PROFILE_SCOPE(Physics);
+        b2World_Step(world_id_, dt, SUB_STEPS);
+    }
+    recordStats();
+}
+
+void PhysicsWorld::recordStats() {
+    // Box2D times every stage of the step itself, whether or not it was
+    // built with BOX2D_PROFILE (that only adds Tracy zones)
+    Profiler& profiler = Profiler::instance();
+    const b2Profile profile = b2World_GetProfile(world_id_);
+    profiler.recordDuration(ProfileZone::PhysicsPairs, fromMs(profile.pairs));
+    profiler.recordDuration(ProfileZone::PhysicsCollide, fromMs(profile.collide));
+    profiler.recordDuration(ProfileZone::PhysicsSolve, fromMs(profile.solve));
+    profiler.recordDuration(ProfileZone::PhysicsConstraints, fromMs(profile.solveConstraints));
+    profiler.recordDuration(ProfileZone::PhysicsContinuous, fromMs(profile.bullets));
+    profiler.recordDuration(ProfileZone::PhysicsRefit, fromMs(profile.refit));
+    profiler.recordDuration(
+        ProfileZone::PhysicsIslands,
+        fromMs(profile.mergeIslands + profile.splitIslands + profile.sleepIslands));
+
+    const b2Counters counters = b2World_GetCounters(world_id_);
+    profiler.setGauge(ProfileGauge::Bodies, counters.bodyCount);
+    profiler.setGauge(ProfileGauge::Shapes, counters.shapeCount);
+    profiler.setGauge(ProfileGauge::Contacts, counters.contactCount);
+    profiler.setGauge(ProfileGauge::Joints, counters.jointCount);
+    profiler.setGauge(ProfileGauge::Islands, counters.islandCount);
+    memory::setUnits(MemoryTag::Box2D, counters.bodyCount);
+    TRACE_COUNTER("bodies live", counters.bodyCount);
 }
@@ -14,8 +14,10 @@ public:
     // Constants
     static constexpr float GRAVITY = -20.0f;
     static constexpr int SUB_STEPS = 4;
-    static constexpr float PIXELS_PER_METER = 30.0f; // Braille pixels per meter
 
 private:
     b2WorldId world_id_;
+
+    // Step breakdown and world sizes into the profiler
+    void recordStats();
 };
@@ -41,6 +41,7 @@ SoftbodyBall::SoftbodyBall(b2WorldId world_id, b2Vec2 start_pos)
         // Add rim shape
         shape_def.density = 0.5f;
         shape_def.material.friction = 1.0f;
+        shape_def.enableHitEvents = true; // Touchdowns throw up dust
         b2Circle rim_circle = {{0, 0}, RIM_CIRCLE_RADIUS};
         b2CreateCircleShape(rim_ids_[i], &shape_def, &rim_circle);
     }
@@ -136,13 +137,13 @@ void SoftbodyBall::startCompression() {
     compression_time_ = 0.0f;
 }
 
-void SoftbodyBall::updateCompression(float dt) {
+void SoftbodyBall::updateCompression(float held_seconds) {
     if (!compressing_) {
         return;
     }
 
-    compression_time_ += dt;
-    compression_time_ = std::min(compression_time_, MAX_COMPRESSION_TIME);
+    // Real press duration, so the charge doesn't depend on frame timing
+    compression_time_ = std::min(held_seconds, MAX_COMPRESSION_TIME);
 
     // Shorten spoke joints to compress the ball
     float compression_factor = 1.0f - (compression_time_ / MAX_COMPRESSION_TIME) * COMPRESSION_RATE;
@@ -204,13 +205,20 @@ b2Vec2 SoftbodyBall::getCenterPosition() const {
     return b2Body_GetPosition(core_id_);
 }
 
-std::vector<b2Vec2> SoftbodyBall::getRimPositions() const {
-    std::vector<b2Vec2> positions;
-    positions.reserve(RIM_COUNT);
+void SoftbodyBall::getRimPositions(std::vector<b2Vec2>& positions) const {
+    positions.clear();
     for (const auto& rim_id : rim_ids_) {
         positions.push_back(b2Body_GetPosition(rim_id));
     }
-    return positions;
+}
+
+bool SoftbodyBall::isRim(b2BodyId body_id) const {
+    for (const auto& rim_id : rim_ids_) {
+        if (B2_ID_EQUALS(rim_id, body_id)) {
+            return true;
+        }
+    }
+    return false;
 }
 
 float SoftbodyBall::getSpeed() const {
@@ -14,16 +14,18 @@ public:
     void applyMovement(float direction); // -1.0 = left, 1.0 = right
     void applyJumpImpulse(float magnitude);
     void startCompression(); // Begin held jump
-    void updateCompression(float dt); // Continue compression while held
+    void updateCompression(float held_seconds); // Compress by how long jump has been held
     void releaseJump(float input_direction = 0.0f); // Release after compression with directional control
 
     // State queries
     b2Vec2 getCenterPosition() const;
-    std::vector<b2Vec2> getRimPositions() const;
+    // Counter-clockwise ring order; fills positions, reusing its capacity
+    void getRimPositions(std::vector<b2Vec2>& positions) const;
     float getSpeed() const;
     bool isOnGround() const;
 
     b2BodyId getCoreBodyId() const { return core_id_; }
+    bool isRim(b2BodyId body_id) const;
 
     // Constants - tuned for testing
     static constexpr int RIM_COUNT = 12;
@@ -1,9 +1,10 @@
 #include "rendering/ball_renderer.hpp"
 
-#include <cmath>
 #include <algorithm>
+#include <array>
+#include <cmath>
 
-void BallRenderer::draw(ftxui::Canvas& canvas,
+void BallRenderer::draw(DrawList& list,
                         const Camera& camera,
                         b2Vec2 core_position,
                         const std::vector<b2Vec2>& rim_positions) {
@@ -11,40 +12,33 @@ void BallRenderer::draw(ftxui::Canvas& canvas,
         return;
     }
 
-    // Sort rim positions by angle from center
-    std::vector<b2Vec2> sorted_rims = sortByAngle(rim_positions);
+    const std::vector<b2Vec2>& ring = ringOrder(core_position, rim_positions);
+    int count = std::min(static_cast<int>(ring.size()), MAX_RIM_POINTS);
 
-    // Convert core to screen coords
+    // Convert core and rims to screen coords
     auto core_screen = camera.worldToScreen(core_position);
-
-    // Convert all rim positions to screen coords
-    std::vector<Camera::ScreenPos> rim_screen;
-    rim_screen.reserve(sorted_rims.size());
-    for (const auto& rim : sorted_rims) {
-        rim_screen.push_back(camera.worldToScreen(rim));
+    std::array<Camera::ScreenPos, MAX_RIM_POINTS> rim_screen;
+    for (int i = 0; i < count; ++i) {
+        rim_screen[i] = camera.worldToScreen(ring[i]);
     }
 
-    // Draw alternating filled / outline-only triangles
-    for (size_t i = 0; i < rim_screen.size(); ++i) {
-        size_t next = (i + 1) % rim_screen.size();
+    // Fill the even wedges in a single span pass
+    fillWedges(list, core_screen, rim_screen.data(), count);
+
+    // Always draw the outline edges so every triangle has visible borders
+    for (int i = 0; i < count; ++i) {
+        int next = (i + 1) % count;
 
         int cx = core_screen.x, cy = core_screen.y;
         int ax = rim_screen[i].x, ay = rim_screen[i].y;
         int bx = rim_screen[next].x, by = rim_screen[next].y;
 
-        if (i % 2 == 0) {
-            // Filled triangle
-            fillTriangle(canvas, cx, cy, ax, ay, bx, by);
-        }
-
-        // Always draw the outline edges so every triangle has visible borders
-        canvas.DrawPointLine(cx, cy, ax, ay);
-        canvas.DrawPointLine(ax, ay, bx, by);
-        canvas.DrawPointLine(bx, by, cx, cy);
+        list.line(cx, cy, ax, ay);
+        list.line(ax, ay, bx, by);
     }
 }
 
-void BallRenderer::drawDebug(ftxui::Canvas& canvas,
+void BallRenderer::drawDebug(DrawList& list,
                              const Camera& camera,
                              b2Vec2 core_position,
                              const std::vector<b2Vec2>& rim_positions,
@@ -55,29 +49,29 @@ void BallRenderer::drawDebug(ftxui::Canvas& canvas,
     }
 
     // Draw core circle
-    drawCircle(canvas, camera, core_position, core_radius);
+    drawCircle(list, camera, core_position, core_radius);
 
     // Draw rim circles
+    auto core_screen = camera.worldToScreen(core_position);
     for (const auto& rim_pos : rim_positions) {
-        drawCircle(canvas, camera, rim_pos, rim_radius);
+        drawCircle(list, camera, rim_pos, rim_radius);
 
         // Draw constraint line from core to rim (spokes)
-        auto core_screen = camera.worldToScreen(core_position);
         auto rim_screen = camera.worldToScreen(rim_pos);
-        canvas.DrawPointLine(core_screen.x, core_screen.y, rim_screen.x, rim_screen.y);
+        list.line(core_screen.x, core_screen.y, rim_screen.x, rim_screen.y);
     }
 
     // Draw ring constraints between adjacent rims
-    std::vector<b2Vec2> sorted_rims = sortByAngle(rim_positions);
-    for (size_t i = 0; i < sorted_rims.size(); ++i) {
-        size_t next = (i + 1) % sorted_rims.size();
-        auto screen_a = camera.worldToScreen(sorted_rims[i]);
-        auto screen_b = camera.worldToScreen(sorted_rims[next]);
-        canvas.DrawPointLine(screen_a.x, screen_a.y, screen_b.x, screen_b.y);
+    const std::vector<b2Vec2>& ring = ringOrder(core_position, rim_positions);
+    for (size_t i = 0; i < ring.size(); ++i) {
+        size_t next = (i + 1) % ring.size();
+        auto screen_a = camera.worldToScreen(ring[i]);
+        auto screen_b = camera.worldToScreen(ring[next]);
+        list.line(screen_a.x, screen_a.y, screen_b.x, screen_b.y);
     }
 }
 
-void BallRenderer::drawCircle(ftxui::Canvas& canvas,
+void BallRenderer::drawCircle(DrawList& list,
                               const Camera& camera,
                               b2Vec2 center,
                               float radius) {
@@ -93,59 +87,71 @@ void BallRenderer::drawCircle(ftxui::Canvas& canvas,
         auto screen1 = camera.worldToScreen(p1);
         auto screen2 = camera.worldToScreen(p2);
 
-        canvas.DrawPointLine(screen1.x, screen1.y, screen2.x, screen2.y);
+        list.line(screen1.x, screen1.y, screen2.x, screen2.y);
     }
 }
 
-void BallRenderer::fillTriangle(ftxui::Canvas& canvas,
-                                int x0, int y0,
-                                int x1, int y1,
-                                int x2, int y2) {
-    // Sort vertices by Y coordinate (top to bottom in screen space)
-    if (y0 > y1) { std::swap(x0, x1); std::swap(y0, y1); }
-    if (y0 > y2) { std::swap(x0, x2); std::swap(y0, y2); }
-    if (y1 > y2) { std::swap(x1, x2); std::swap(y1, y2); }
-
-    // Degenerate triangle
-    if (y0 == y2) return;
-
-    // Scanline fill
-    for (int y = y0; y <= y2; ++y) {
-        // Compute x range for this scanline by interpolating along edges
-        // Edge 0-2 always spans the full height
-        float t_long = static_cast<float>(y - y0) / (y2 - y0);
-        float x_long = x0 + t_long * (x2 - x0);
-
-        float x_short;
-        if (y < y1) {
-            // Upper half: edge 0-1
-            if (y1 == y0) {
-                x_short = static_cast<float>(x1);
-            } else {
-                float t = static_cast<float>(y - y0) / (y1 - y0);
-                x_short = x0 + t * (x1 - x0);
-            }
-        } else {
-            // Lower half: edge 1-2
-            if (y2 == y1) {
-                x_short = static_cast<float>(x1);
-            } else {
-                float t = static_cast<float>(y - y1) / (y2 - y1);
-                x_short = x1 + t * (x2 - x1);
-            }
+void BallRenderer::fillWedges(DrawList& list,
+                              Camera::ScreenPos core,
+                              const Camera::ScreenPos* rim,
+                              int count) {
+    if (count < 3) {
+        return;
+    }
+
+    // Wedge i (core, rim[i], rim[i+1]) is filled when i is even. A spoke is
+    // shared by two wedges and only bounds the fill where their states differ;
+    // the rim edge of each filled wedge always does.
+    std::array<DrawList::Edge, MAX_RIM_POINTS * 2> edges;
+    int edge_count = 0;
+    for (int i = 0; i < count; ++i) {
+        int prev = (i + count - 1) % count;
+        int next = (i + 1) % count;
+        bool filled = (i % 2 == 0);
+        bool prev_filled = (prev % 2 == 0);
+
+        if (filled != prev_filled) {
+            edges[edge_count++] = {core.x, core.y, rim[i].x, rim[i].y};
         }
+        if (filled) {
+            edges[edge_count++] = {rim[i].x, rim[i].y, rim[next].x, rim[next].y};
+        }
+    }
 
-        int xa = static_cast<int>(x_long);
-        int xb = static_cast<int>(x_short);
-        if (xa > xb) std::swap(xa, xb);
+    list.evenOddFill(edges.data(), edge_count);
+}
 
-        canvas.DrawPointLine(xa, y, xb, y);
+bool BallRenderer::isRingOrdered(b2Vec2 core_position,
+                                 const std::vector<b2Vec2>& rim_positions) const {
+    // Rims are created counter-clockwise; each adjacent pair must keep a
+    // positive cross product about the core or the ring has folded.
+    size_t count = rim_positions.size();
+    for (size_t i = 0; i < count; ++i) {
+        const b2Vec2& a = rim_positions[i];
+        const b2Vec2& b = rim_positions[(i + 1) % count];
+        float ax = a.x - core_position.x, ay = a.y - core_position.y;
+        float bx = b.x - core_position.x, by = b.y - core_position.y;
+        if (ax * by - ay * bx <= 0.0f) {
+            return false;
+        }
     }
+    return true;
 }
 
-std::vector<b2Vec2> BallRenderer::sortByAngle(const std::vector<b2Vec2>& rim_positions) {
+const std::vector<b2Vec2>& BallRenderer::ringOrder(b2Vec2 core_position,
+                                                   const std::vector<b2Vec2>& rim_positions) {
+    if (isRingOrdered(core_position, rim_positions)) {
+        return rim_positions;
+    }
+    sortByAngle(rim_positions, sorted_rims_);
+    return sorted_rims_;
+}
+
+void BallRenderer::sortByAngle(const std::vector<b2Vec2>& rim_positions,
+                               std::vector<b2Vec2>& sorted) {
+    sorted.assign(rim_positions.begin(), rim_positions.end());
     if (rim_positions.empty()) {
-        return {};
+        return;
     }
 
     // Find center
@@ -158,12 +164,9 @@ std::vector<b2Vec2> BallRenderer::sortByAngle(const std::vector<b2Vec2>& rim_pos
     center.y /= rim_positions.size();
 
     // Sort by angle
-    std::vector<b2Vec2> sorted = rim_positions;
     std::sort(sorted.begin(), sorted.end(), [&center](const b2Vec2& a, const b2Vec2& b) {
         float angle_a = atan2f(a.y - center.y, a.x - center.x);
         float angle_b = atan2f(b.y - center.y, b.x - center.x);
         return angle_a < angle_b;
     });
-
-    return sorted;
 }
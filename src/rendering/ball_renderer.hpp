@@ -1,8 +1,8 @@
 #pragma once
 
 #include "rendering/camera.hpp"
+#include "rendering/draw_list.hpp"
 
-#include <ftxui/dom/canvas.hpp>
 #include <box2d/box2d.h>
 
 #include <vector>
@@ -11,32 +11,51 @@ class BallRenderer {
 public:
     BallRenderer() = default;
 
-    // Draw ball as alternating filled/unfilled triangles from core to rim pairs
-    void draw(ftxui::Canvas& canvas,
+    // Draw ball as alternating filled/unfilled triangles from core to rim pairs.
+    // Rim positions are expected in ring order (as created by SoftbodyBall).
+    void draw(DrawList& list,
               const Camera& camera,
               b2Vec2 core_position,
               const std::vector<b2Vec2>& rim_positions);
 
     // Debug draw mode showing physics bodies
-    void drawDebug(ftxui::Canvas& canvas,
+    void drawDebug(DrawList& list,
                    const Camera& camera,
                    b2Vec2 core_position,
                    const std::vector<b2Vec2>& rim_positions,
                    float core_radius,
                    float rim_radius);
 
+    // Upper bound on rim bodies the renderer handles (fixed scratch storage)
+    static constexpr int MAX_RIM_POINTS = 32;
+
 private:
-    // Sort rim positions by angle from center for proper spline ordering
-    std::vector<b2Vec2> sortByAngle(const std::vector<b2Vec2>& rim_positions);
+    // True if every rim wedge winds the same way around the core, i.e. the
+    // ring has not folded over itself and its construction order is usable.
+    bool isRingOrdered(b2Vec2 core_position,
+                       const std::vector<b2Vec2>& rim_positions) const;
+
+    // Sort rim positions by angle from center into sorted (fallback for a
+    // folded ring)
+    static void sortByAngle(const std::vector<b2Vec2>& rim_positions,
+                            std::vector<b2Vec2>& sorted);
 
-    void drawCircle(ftxui::Canvas& canvas,
+    // Return rim positions in ring order, sorting only if the ring is folded
+    const std::vector<b2Vec2>& ringOrder(b2Vec2 core_position,
+                                         const std::vector<b2Vec2>& rim_positions);
+
+    void drawCircle(DrawList& list,
                     const Camera& camera,
                     b2Vec2 center,
                     float radius);
 
-    // Scanline-fill a triangle in screen (braille) coordinates
-    void fillTriangle(ftxui::Canvas& canvas,
-                      int x0, int y0,
-                      int x1, int y1,
-                      int x2, int y2);
+    // Fill every even wedge (core, rim[i], rim[i+1]) as one even-odd polygon
+    // in screen (braille) coordinates, so each scanline is one sorted list
+    // of crossings.
+    void fillWedges(DrawList& list,
+                    Camera::ScreenPos core,
+                    const Camera::ScreenPos* rim,
+                    int count);
+
+    std::vector<b2Vec2> sorted_rims_; // Fallback storage for a folded ring
 };
@@ -0,0 +1,49 @@
+#include "rendering/band_rasterizer.hpp"
+
+#include <algorithm>
+#include <thread>
+
+BandRasterizer::BandRasterizer(int thread_count)
+    : pool_(std::max(1, thread_count)) {}
+
+int BandRasterizer::defaultThreadCount() {
+    int hw = static_cast<int>(std::thread::hardware_concurrency());
+    return std::clamp(hw, 1, MAX_THREADS);
+}
+
+void BandRasterizer::rasterize(const DrawList& list, PixelCanvas& canvas) {
+    canvas.clear();
+    if (canvas.height() == 0 || list.size() == 0) {
+        return;
+    }
+
+    // Band height in whole cell rows
+    int cell_rows = canvas.cellHeight();
+    int band_count = std::min(pool_.threadCount() * BANDS_PER_THREAD,
+                              std::max(1, cell_rows / MIN_BAND_CELL_ROWS));
+    int band_rows = ((cell_rows + band_count - 1) / band_count) * canvas.cellPixelHeight();
+    band_count = (canvas.height() + band_rows - 1) / band_rows;
+
+    // Bin each command into every band its row range overlaps
+    if (static_cast<int>(bins_.size()) < band_count) {
+        bins_.resize(band_count);
+    }
+    for (int b = 0; b < band_count; ++b) {
+        bins_[b].clear();
+    }
+    for (size_t i = 0; i < list.size(); ++i) {
+        int first = std::max(list.top(i), 0) / band_rows;
+        int last = std::min(list.bottom(i) / band_rows, band_count - 1);
+        for (int b = first; b <= last; ++b) {
+            bins_[b].push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    auto draw_band = [&](int b) {
+        RasterBand band(canvas, b * band_rows, (b + 1) * band_rows);
+        for (uint32_t index : bins_[b]) {
+            list.execute(index, band);
+        }
+    };
+    pool_.parallelFor(band_count, draw_band);
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "rendering/draw_list.hpp"
+#include "rendering/pixel_canvas.hpp"
+#include "rendering/thread_pool.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// Rasterizes a DrawList into a PixelCanvas as horizontal bands on a thread
+// pool. Band edges fall on character cell rows, so bands never share pixel
+// words or ink cells, and each band replays its commands in recorded order:
+// the result is identical for any thread count.
+class BandRasterizer {
+public:
+    explicit BandRasterizer(int thread_count = defaultThreadCount());
+
+    void rasterize(const DrawList& list, PixelCanvas& canvas);
+
+    int threadCount() const { return pool_.threadCount(); }
+
+    // Hardware threads, capped - past a few bands the merge-free split
+    // stops paying for the wakeups
+    static int defaultThreadCount();
+
+private:
+    static constexpr int MIN_BAND_CELL_ROWS = 6;
+    static constexpr int BANDS_PER_THREAD = 2; // Balances the busy middle band
+    static constexpr int MAX_THREADS = 8;
+
+    ThreadPool pool_;
+    std::vector<std::vector<uint32_t>> bins_; // Command indices per band
+};
@@ -1,5 +1,6 @@
 #include "rendering/camera.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 Camera::Camera() = default;
@@ -8,6 +9,12 @@ void Camera::update(b2Vec2 target_pos, float dt) {
     // Keep ball centered on screen (reduce smoothing for tighter tracking)
     focus_.x = target_pos.x;  // No smoothing on X - keep ball centered horizontally
     focus_.y += (target_pos.y - focus_.y) * 0.3f;  // Slight smoothing on Y for stability
+
+    zoom_ += (target_zoom_ - zoom_) * std::min(1.0f, ZOOM_RATE * dt);
+}
+
+void Camera::setZoom(float zoom) {
+    target_zoom_ = std::clamp(zoom, MIN_ZOOM, MAX_ZOOM);
 }
 
 void Camera::setScreenSize(int width, int height) {
@@ -27,30 +34,31 @@ Camera::ScreenPos Camera::worldToScreen(b2Vec2 world_pos, float parallax_factor)
     float world_y_rel = world_pos.y - parallax_focus.y;
 
     // Convert to screen pixels (Y-down)
-    int screen_x = static_cast<int>(screen_width_ / 2 + world_x_rel * pixels_per_meter_);
-    int screen_y = static_cast<int>(screen_height_ / 2 - world_y_rel * pixels_per_meter_);
+    float pixels_per_meter = pixelsPerMeter();
+    int screen_x = static_cast<int>(screen_width_ / 2 + world_x_rel * pixels_per_meter);
+    int screen_y = static_cast<int>(screen_height_ / 2 - world_y_rel * pixels_per_meter);
 
     return {screen_x, screen_y};
 }
 
 b2Vec2 Camera::screenToWorld(int screen_x, int screen_y) const {
-    float world_x = focus_.x + (screen_x - screen_width_ / 2) / pixels_per_meter_;
-    float world_y = focus_.y - (screen_y - screen_height_ / 2) / pixels_per_meter_;
+    float world_x = focus_.x + (screen_x - screen_width_ / 2) / pixelsPerMeter();
+    float world_y = focus_.y - (screen_y - screen_height_ / 2) / pixelsPerMeter();
     return {world_x, world_y};
 }
 
 float Camera::viewportLeft() const {
-    return focus_.x - (screen_width_ / 2) / pixels_per_meter_;
+    return focus_.x - (screen_width_ / 2) / pixelsPerMeter();
 }
 
 float Camera::viewportRight() const {
-    return focus_.x + (screen_width_ / 2) / pixels_per_meter_;
+    return focus_.x + (screen_width_ / 2) / pixelsPerMeter();
 }
 
 float Camera::viewportTop() const {
-    return focus_.y + (screen_height_ / 2) / pixels_per_meter_;
+    return focus_.y + (screen_height_ / 2) / pixelsPerMeter();
 }
 
 float Camera::viewportBottom() const {
-    return focus_.y - (screen_height_ / 2) / pixels_per_meter_;
+    return focus_.y - (screen_height_ / 2) / pixelsPerMeter();
 }
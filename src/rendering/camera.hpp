@@ -4,13 +4,29 @@
 
 class Camera {
 public:
+    // Braille pixels per world meter at zoom 1 (two per character column)
+    static constexpr float PIXELS_PER_METER = 30.0f;
+    static constexpr float MIN_ZOOM = 0.05f;
+    static constexpr float MAX_ZOOM = 2.0f;
+
     Camera();
 
-    // Update camera to track target position
+    // Update camera to track target position and ease toward the target zoom
     void update(b2Vec2 target_pos, float dt);
 
-    // Set screen dimensions (in braille pixels)
+    // Set screen dimensions (in canvas pixels)
     void setScreenSize(int width, int height);
+    int screenWidth() const { return screen_width_; }
+    int screenHeight() const { return screen_height_; }
+
+    // Canvas pixels per world meter at zoom 1; depends on the cell encoding
+    void setBasePixelsPerMeter(float pixels_per_meter) { base_pixels_per_meter_ = pixels_per_meter; }
+    float basePixelsPerMeter() const { return base_pixels_per_meter_; }
+    float pixelsPerMeter() const { return base_pixels_per_meter_ * zoom_; }
+
+    // Zoom < 1 shows more of the world. The view eases toward the target.
+    void setZoom(float zoom);
+    float zoom() const { return zoom_; }
 
     // Convert world coords to screen pixel coords
     struct ScreenPos {
@@ -32,8 +48,11 @@ public:
 
 private:
     b2Vec2 focus_ = {0, 0};
-    int screen_width_ = 0;   // In braille pixels
+    int screen_width_ = 0;   // In canvas pixels
     int screen_height_ = 0;
     float smoothing_ = 0.1f; // Camera lerp factor
-    float pixels_per_meter_ = 30.0f; // From PhysicsWorld::PIXELS_PER_METER
+    float base_pixels_per_meter_ = PIXELS_PER_METER;
+    float zoom_ = 1.0f;
+    float target_zoom_ = 1.0f;
+    static constexpr float ZOOM_RATE = 4.0f; // Fraction of the zoom gap closed per second
 };
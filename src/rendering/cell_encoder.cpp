@@ -0,0 +1,136 @@
+#include "rendering/cell_encoder.hpp"
+
+namespace {
+
+std::string utf8(char32_t code_point) {
+    std::string out;
+    if (code_point < 0x80) {
+        out += static_cast<char>(code_point);
+    } else if (code_point < 0x800) {
+        out += static_cast<char>(0xC0 | (code_point >> 6));
+        out += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else if (code_point < 0x10000) {
+        out += static_cast<char>(0xE0 | (code_point >> 12));
+        out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (code_point >> 18));
+        out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+    return out;
+}
+
+// 2x4 masks: bit 0 = top-left, bit 1 = top-right, ... bit 7 = bottom-right
+constexpr uint8_t UPPER_LEFT = 0x05;  // Quadrants
+constexpr uint8_t UPPER_RIGHT = 0x0A;
+constexpr uint8_t LOWER_LEFT = 0x50;
+constexpr uint8_t LOWER_RIGHT = 0xA0;
+
+} // namespace
+
+const CellEncoder& CellEncoder::get(CellEncoding encoding) {
+    static const CellEncoder encoders[] = {
+        CellEncoder(CellEncoding::Braille),
+        CellEncoder(CellEncoding::Octant),
+        CellEncoder(CellEncoding::HalfBlock),
+    };
+    return encoders[static_cast<int>(encoding)];
+}
+
+const char* CellEncoder::name(CellEncoding encoding) {
+    switch (encoding) {
+        case CellEncoding::Braille:   return "Braille";
+        case CellEncoding::Octant:    return "Octant";
+        case CellEncoding::HalfBlock: return "Half-block";
+    }
+    return "";
+}
+
+CellEncoding CellEncoder::next(CellEncoding encoding) {
+    switch (encoding) {
+        case CellEncoding::Braille:   return CellEncoding::Octant;
+        case CellEncoding::Octant:    return CellEncoding::HalfBlock;
+        case CellEncoding::HalfBlock: break;
+    }
+    return CellEncoding::Braille;
+}
+
+CellEncoder::CellEncoder(CellEncoding encoding)
+    : encoding_(encoding) {
+    switch (encoding) {
+        case CellEncoding::Braille:   buildBraille(); break;
+        case CellEncoding::Octant:    buildOctant(); break;
+        case CellEncoding::HalfBlock: buildHalfBlock(); break;
+    }
+}
+
+void CellEncoder::buildBraille() {
+    cell_width_ = 2;
+    cell_height_ = 4;
+
+    // Dots 1-3 run down the left column, 4-6 down the right, 7-8 below
+    constexpr int dot_for_bit[8] = {0, 3, 1, 4, 2, 5, 6, 7};
+    for (int mask = 0; mask < 256; ++mask) {
+        int dots = 0;
+        for (int bit = 0; bit < 8; ++bit) {
+            if (mask & (1 << bit)) {
+                dots |= 1 << dot_for_bit[bit];
+            }
+        }
+        glyphs_[mask] = utf8(0x2800 + dots);
+    }
+}
+
+void CellEncoder::buildOctant() {
+    cell_width_ = 2;
+    cell_height_ = 4;
+
+    // Patterns that already had a character before Unicode 16 are not
+    // repeated in the octant block; every other mask maps to U+1CD00
+    // onwards in increasing mask order.
+    glyphs_[0x00] = " ";
+    glyphs_[UPPER_LEFT] = utf8(0x2598);                                // ▘
+    glyphs_[UPPER_RIGHT] = utf8(0x259D);                               // ▝
+    glyphs_[LOWER_LEFT] = utf8(0x2596);                                // ▖
+    glyphs_[LOWER_RIGHT] = utf8(0x2597);                               // ▗
+    glyphs_[UPPER_LEFT | UPPER_RIGHT] = utf8(0x2580);                  // ▀
+    glyphs_[LOWER_LEFT | LOWER_RIGHT] = utf8(0x2584);                  // ▄
+    glyphs_[UPPER_LEFT | LOWER_LEFT] = utf8(0x258C);                   // ▌
+    glyphs_[UPPER_RIGHT | LOWER_RIGHT] = utf8(0x2590);                 // ▐
+    glyphs_[UPPER_LEFT | LOWER_RIGHT] = utf8(0x259A);                  // ▚
+    glyphs_[UPPER_RIGHT | LOWER_LEFT] = utf8(0x259E);                  // ▞
+    glyphs_[UPPER_LEFT | UPPER_RIGHT | LOWER_LEFT] = utf8(0x259B);     // ▛
+    glyphs_[UPPER_LEFT | UPPER_RIGHT | LOWER_RIGHT] = utf8(0x259C);    // ▜
+    glyphs_[UPPER_LEFT | LOWER_LEFT | LOWER_RIGHT] = utf8(0x2599);     // ▙
+    glyphs_[UPPER_RIGHT | LOWER_LEFT | LOWER_RIGHT] = utf8(0x259F);    // ▟
+    glyphs_[0xFF] = utf8(0x2588);                                      // █
+    glyphs_[0x03] = utf8(0x1FB82); // Upper one quarter block
+    glyphs_[0xC0] = utf8(0x2582);  // Lower one quarter block
+    glyphs_[0x3F] = utf8(0x1FB85); // Upper three quarters block
+    glyphs_[0xFC] = utf8(0x2586);  // Lower three quarters block
+    glyphs_[0x14] = utf8(0x1FBE6); // Middle left one quarter block
+    glyphs_[0x28] = utf8(0x1FBE7); // Middle right one quarter block
+    glyphs_[0x01] = utf8(0x1CEA8); // Left half upper one quarter block
+    glyphs_[0x02] = utf8(0x1CEAB); // Right half upper one quarter block
+    glyphs_[0x40] = utf8(0x1CEA3); // Left half lower one quarter block
+    glyphs_[0x80] = utf8(0x1CEA0); // Right half lower one quarter block
+
+    char32_t next_octant = 0x1CD00;
+    for (int mask = 0; mask < 256; ++mask) {
+        if (glyphs_[mask].empty()) {
+            glyphs_[mask] = utf8(next_octant++);
+        }
+    }
+}
+
+void CellEncoder::buildHalfBlock() {
+    cell_width_ = 1;
+    cell_height_ = 2;
+
+    glyphs_[0] = " ";
+    glyphs_[1] = utf8(0x2580); // ▀
+    glyphs_[2] = utf8(0x2584); // ▄
+    glyphs_[3] = utf8(0x2588); // █
+}
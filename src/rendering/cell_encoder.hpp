@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+// How PixelCanvas cells become characters
+enum class CellEncoding : uint8_t {
+    Braille,   // 2x4 dots, U+2800 block; widest font support
+    Octant,    // 2x4 solid blocks, Unicode 16 octants; needs a recent font
+    HalfBlock, // 1x2 with ▀ ▄ █; coarse but solid and universally supported
+};
+
+// Glyph table for one encoding, indexed by a PixelCanvas cell mask
+// (row-major: bit y * cellWidth() + x is the sub-pixel at (x, y)).
+// Tables are built once and shared.
+class CellEncoder {
+public:
+    static const CellEncoder& get(CellEncoding encoding);
+    static const char* name(CellEncoding encoding);
+    static CellEncoding next(CellEncoding encoding);
+
+    CellEncoding encoding() const { return encoding_; }
+
+    // Sub-pixels per character cell
+    int cellWidth() const { return cell_width_; }
+    int cellHeight() const { return cell_height_; }
+
+    // UTF-8 glyph for a cell mask
+    const std::string& glyph(uint8_t mask) const { return glyphs_[mask]; }
+
+private:
+    explicit CellEncoder(CellEncoding encoding);
+
+    void buildBraille();
+    void buildOctant();
+    void buildHalfBlock();
+
+    CellEncoding encoding_;
+    int cell_width_ = 2;
+    int cell_height_ = 4;
+    std::array<std::string, 256> glyphs_;
+};
@@ -0,0 +1,140 @@
+#include "rendering/draw_list.hpp"
+
+#include <algorithm>
+#include <limits>
+
+void DrawList::clear() {
+    commands_.clear();
+    edges_.clear();
+    sprites_.clear();
+    surfaces_.clear();
+    star_fields_.clear();
+    points_.clear();
+    heights_.clear();
+}
+
+void DrawList::line(int x0, int y0, int x1, int y1) {
+    auto first = static_cast<uint32_t>(edges_.size());
+    edges_.push_back({x0, y0, x1, y1});
+    commands_.push_back({Kind::Line, Ink::Default, std::min(y0, y1), std::max(y0, y1), first, 1});
+}
+
+void DrawList::evenOddFill(const Edge* edges, int count) {
+    if (count < 2) {
+        return;
+    }
+
+    auto first = static_cast<uint32_t>(edges_.size());
+    int y_min = edges[0].y0, y_max = edges[0].y0;
+    for (int i = 0; i < count; ++i) {
+        edges_.push_back(edges[i]);
+        y_min = std::min({y_min, edges[i].y0, edges[i].y1});
+        y_max = std::max({y_max, edges[i].y0, edges[i].y1});
+    }
+    commands_.push_back({Kind::Fill, Ink::Default, y_min, y_max, first,
+                         static_cast<uint32_t>(count)});
+}
+
+void DrawList::sprite(const PixelSprite& sprite, int x, int y, Ink ink) {
+    if (sprite.height == 0) {
+        return;
+    }
+
+    auto first = static_cast<uint32_t>(sprites_.size());
+    sprites_.push_back({&sprite, x, y});
+    commands_.push_back({Kind::Sprite, ink, y, y + sprite.height - 1, first, 1});
+}
+
+void DrawList::surfaceFill(const int* surface, int x0, int count, bool dither) {
+    if (count <= 0) {
+        return;
+    }
+
+    auto first = static_cast<uint32_t>(heights_.size());
+    heights_.insert(heights_.end(), surface, surface + count);
+    int y_min = *std::min_element(surface, surface + count);
+
+    // Reaches the bottom of any canvas
+    auto ref = static_cast<uint32_t>(surfaces_.size());
+    surfaces_.push_back({first, x0, count, dither});
+    commands_.push_back({Kind::Surface, Ink::Default, y_min,
+                         std::numeric_limits<int>::max(), ref, 1});
+}
+
+void DrawList::span(int y, int x0, int x1) {
+    auto first = static_cast<uint32_t>(edges_.size());
+    edges_.push_back({x0, y, x1, y});
+    commands_.push_back({Kind::Span, Ink::Default, y, y, first, 1});
+}
+
+void DrawList::points(const Point* points, int count) {
+    if (count <= 0) {
+        return;
+    }
+
+    auto first = static_cast<uint32_t>(points_.size());
+    int y_min = points[0].y, y_max = points[0].y;
+    for (int i = 0; i < count; ++i) {
+        points_.push_back(points[i]);
+        y_min = std::min(y_min, points[i].y);
+        y_max = std::max(y_max, points[i].y);
+    }
+    commands_.push_back({Kind::Points, Ink::Default, y_min, y_max, first,
+                         static_cast<uint32_t>(count)});
+}
+
+void DrawList::tiled(const PixelSprite& tile, int scroll_x, int y) {
+    if (tile.height == 0) {
+        return;
+    }
+
+    auto first = static_cast<uint32_t>(sprites_.size());
+    sprites_.push_back({&tile, scroll_x, y});
+    commands_.push_back({Kind::Tiled, Ink::Default, y, y + tile.height - 1, first, 1});
+}
+
+void DrawList::starField(const StarField& field, int height) {
+    auto first = static_cast<uint32_t>(star_fields_.size());
+    star_fields_.push_back(field);
+    commands_.push_back({Kind::Stars, Ink::Default, 0, height - 1, first, 1});
+}
+
+void DrawList::execute(size_t index, RasterBand& band) const {
+    const Command& cmd = commands_[index];
+    switch (cmd.kind) {
+        case Kind::Line: {
+            const Edge& e = edges_[cmd.first];
+            band.drawLine(e.x0, e.y0, e.x1, e.y1);
+            break;
+        }
+        case Kind::Fill:
+            band.fillEvenOdd(&edges_[cmd.first], static_cast<int>(cmd.count));
+            break;
+        case Kind::Sprite: {
+            const SpriteRef& ref = sprites_[cmd.first];
+            band.blit(*ref.sprite, ref.x, ref.y, cmd.ink);
+            break;
+        }
+        case Kind::Surface: {
+            const SurfaceRef& ref = surfaces_[cmd.first];
+            band.fillBelow(&heights_[ref.first], ref.x0, ref.count, ref.dither);
+            break;
+        }
+        case Kind::Span: {
+            const Edge& e = edges_[cmd.first];
+            band.fillSpan(e.y0, e.x0, e.x1);
+            break;
+        }
+        case Kind::Points:
+            band.plotPoints(&points_[cmd.first], static_cast<int>(cmd.count));
+            break;
+        case Kind::Tiled: {
+            const SpriteRef& ref = sprites_[cmd.first];
+            band.blitTiled(*ref.sprite, ref.x, ref.y);
+            break;
+        }
+        case Kind::Stars:
+            band.starField(star_fields_[cmd.first]);
+            break;
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "rendering/pixel_canvas.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Draw commands for one frame in screen (braille pixel) coordinates.
+// Renderers record into the list; BandRasterizer bins the commands by
+// their row range and replays them band by band.
+class DrawList {
+public:
+    using Edge = RasterBand::Edge;
+    using Point = RasterBand::Point;
+
+    void clear();
+
+    void line(int x0, int y0, int x1, int y1);
+    void evenOddFill(const Edge* edges, int count);
+    void sprite(const PixelSprite& sprite, int x, int y, Ink ink = Ink::Default);
+    // Fill below a per-column surface: surface[i] is the top row of column x0 + i
+    void surfaceFill(const int* surface, int x0, int count, bool dither);
+    // Horizontal span of row y, endpoints inclusive
+    void span(int y, int x0, int x1);
+    // One command for a batch of single pixels (particles)
+    void points(const Point* points, int count);
+    // Background layers spanning the whole width (see RasterBand)
+    void tiled(const PixelSprite& tile, int scroll_x, int y);
+    void starField(const StarField& field, int height);
+
+    size_t size() const { return commands_.size(); }
+
+    // Row range [top, bottom] touched by a command
+    int top(size_t index) const { return commands_[index].y_min; }
+    int bottom(size_t index) const { return commands_[index].y_max; }
+
+    // Replay one command into a band
+    void execute(size_t index, RasterBand& band) const;
+
+private:
+    enum class Kind : uint8_t { Line, Fill, Sprite, Surface, Span, Points, Tiled, Stars };
+
+    struct Command {
+        Kind kind;
+        Ink ink;
+        int y_min;
+        int y_max;
+        uint32_t first; // Index into edges_ (Line/Fill/Span), sprites_ (Sprite/Tiled),
+                        // surfaces_, points_ or star_fields_
+        uint32_t count;
+    };
+
+    struct SpriteRef {
+        const PixelSprite* sprite;
+        int x;
+        int y;
+    };
+
+    struct SurfaceRef {
+        uint32_t first; // Index into heights_
+        int x0;
+        int count;
+        bool dither;
+    };
+
+    std::vector<Command> commands_;
+    std::vector<Edge> edges_;
+    std::vector<SpriteRef> sprites_;
+    std::vector<SurfaceRef> surfaces_;
+    std::vector<StarField> star_fields_;
+    std::vector<Point> points_;
+    std::vector<int> heights_;
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "rendering/camera.hpp"
+#include "rendering/cell_encoder.hpp"
+#include "rendering/terrain_renderer.hpp"
+
+#include <box2d/box2d.h>
+
+#include <cstdint>
+#include <vector>
+
+// Immutable description of one game frame, copied out of the simulation so
+// the render thread can draw it while the next physics step runs. Vectors
+// keep their capacity between frames.
+struct FrameSnapshot {
+    // Visible terrain polyline: points [first, first + count) of terrain_points
+    struct TerrainRun {
+        uint32_t first = 0;
+        uint32_t count = 0;
+        bool is_goal = false;
+        float goal_x = 0.0f;
+    };
+
+    uint64_t frame_id = 0;
+    Camera camera;
+    CellEncoding cell_encoding = CellEncoding::Braille;
+    TerrainFill terrain_fill = TerrainFill::Outline;
+    bool background = true;
+    bool debug = false;
+
+    b2Vec2 core_position = {0, 0};
+    float speed = 0.0f;
+    std::vector<b2Vec2> rim_positions; // Ring order
+    b2Vec2 mask_position = {0, 0};
+
+    // Visible particles, world space
+    std::vector<b2Vec2> dust;
+    std::vector<b2Vec2> streaks;
+
+    std::vector<b2Vec2> terrain_points;
+    std::vector<TerrainRun> terrain_runs;
+};
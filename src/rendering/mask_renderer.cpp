@@ -4,7 +4,14 @@
 #include "rendering/mask_renderer.hpp"
 
 #include <algorithm>
-#include <cmath>
+
+namespace {
+
+// Image offset from the mask body, in meters (tuned in pixels at zoom 1)
+constexpr float IMAGE_OFFSET_X = 10.0f / Camera::PIXELS_PER_METER;
+constexpr float IMAGE_OFFSET_Y = 15.0f / Camera::PIXELS_PER_METER;
+
+} // namespace
 
 MaskRenderer::MaskRenderer(const std::string& image_path, float world_width)
     : world_width_(world_width) {
@@ -15,66 +22,60 @@ MaskRenderer::MaskRenderer(const std::string& image_path, float world_width)
         return;
     }
 
-    // Target size: world_width in meters * 30 pixels/meter = braille pixels wide
-    // Now we work directly in braille pixel space (1x1 resolution)
-    constexpr float pixels_per_meter = 30.0f;
-    int target_braille_width = static_cast<int>(world_width * pixels_per_meter);
-    if (target_braille_width < 1) target_braille_width = 1;
-
-    // Maintain aspect ratio
-    float aspect = static_cast<float>(img_h) / static_cast<float>(img_w);
-    int target_braille_height = static_cast<int>(target_braille_width * aspect);
-    if (target_braille_height < 1) target_braille_height = 1;
-
-    braille_width_ = target_braille_width;
-    braille_height_ = target_braille_height;
-
-    // Sample the source image at braille resolution using nearest-neighbor
-    auto sample = [&](int bx, int by) -> std::array<unsigned char, 4> {
-        // Map braille coords to source image coords
-        int src_x = std::clamp(bx * img_w / target_braille_width, 0, img_w - 1);
-        int src_y = std::clamp(by * img_h / target_braille_height, 0, img_h - 1);
-        int idx = (src_y * img_w + src_x) * 4;
-        return {data[idx], data[idx + 1], data[idx + 2], data[idx + 3]};
-    };
-
     constexpr unsigned char alpha_threshold = 128;
 
-    // Build braille pixel data - store only opaque pixels
-    for (int by = 0; by < target_braille_height; ++by) {
-        for (int bx = 0; bx < target_braille_width; ++bx) {
-            auto rgba = sample(bx, by);
-            if (rgba[3] >= alpha_threshold) {
-                BraillePixel bp;
-                bp.dx = bx;
-                bp.dy = by;
-                pixels_.push_back(bp);
-            }
-        }
+    // Keep only opacity; the sprite is resampled from it for each pixel density
+    image_width_ = img_w;
+    image_height_ = img_h;
+    opaque_.resize(static_cast<size_t>(img_w) * img_h);
+    for (size_t i = 0; i < opaque_.size(); ++i) {
+        opaque_[i] = data[i * 4 + 3] >= alpha_threshold;
     }
 
     stbi_image_free(data);
     loaded_ = true;
 }
 
-void MaskRenderer::draw(ftxui::Canvas& canvas, const Camera& camera, b2Vec2 mask_position) {
-    if (!loaded_ || pixels_.empty()) {
+void MaskRenderer::buildSprite(float pixels_per_meter) {
+    // Target size: world_width in meters * pixels/meter = canvas pixels wide
+    int target_width = static_cast<int>(world_width_ * pixels_per_meter);
+    if (target_width < 1) target_width = 1;
+
+    // Maintain aspect ratio
+    float aspect = static_cast<float>(image_height_) / static_cast<float>(image_width_);
+    int target_height = static_cast<int>(target_width * aspect);
+    if (target_height < 1) target_height = 1;
+
+    // Sample the source image at canvas resolution using nearest-neighbor;
+    // only opaque pixels are set
+    sprite_.resize(target_width, target_height);
+    for (int py = 0; py < target_height; ++py) {
+        int src_y = std::clamp(py * image_height_ / target_height, 0, image_height_ - 1);
+        for (int px = 0; px < target_width; ++px) {
+            int src_x = std::clamp(px * image_width_ / target_width, 0, image_width_ - 1);
+            if (opaque_[static_cast<size_t>(src_y) * image_width_ + src_x]) {
+                sprite_.set(px, py);
+            }
+        }
+    }
+    sprite_pixels_per_meter_ = pixels_per_meter;
+}
+
+void MaskRenderer::draw(DrawList& list, const Camera& camera, b2Vec2 mask_position) {
+    if (!loaded_) {
         return;
     }
+    if (camera.pixelsPerMeter() != sprite_pixels_per_meter_) {
+        buildSprite(camera.pixelsPerMeter());
+    }
 
     auto screen_center = camera.worldToScreen(mask_position);
 
     // Offset to center the image on the mask position
-    int origin_x = screen_center.x - braille_width_ / 2 - 10;
-    int origin_y = screen_center.y - braille_height_ / 2 - 15;
-
-    for (const auto& bp : pixels_) {
-        int px = origin_x + bp.dx;
-        int py = origin_y + bp.dy;
+    int origin_x = screen_center.x - sprite_.width / 2 -
+                   static_cast<int>(IMAGE_OFFSET_X * sprite_pixels_per_meter_);
+    int origin_y = screen_center.y - sprite_.height / 2 -
+                   static_cast<int>(IMAGE_OFFSET_Y * sprite_pixels_per_meter_);
 
-        // Bounds check
-        if (px < 0 || py < 0) continue;
-
-        canvas.DrawPoint(px, py, true, ftxui::Color::Orange1);
-    }
+    list.sprite(sprite_, origin_x, origin_y, Ink::Mask);
 }
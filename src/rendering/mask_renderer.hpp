@@ -1,10 +1,12 @@
 #pragma once
 
 #include "rendering/camera.hpp"
+#include "rendering/draw_list.hpp"
+#include "rendering/pixel_canvas.hpp"
 
-#include <ftxui/dom/canvas.hpp>
 #include <box2d/box2d.h>
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -12,7 +14,9 @@ class MaskRenderer {
 public:
     explicit MaskRenderer(const std::string& image_path, float world_width = 1.2f);
 
-    void draw(ftxui::Canvas& canvas, const Camera& camera, b2Vec2 mask_position);
+    // Rescales the sprite when the camera's pixel density changes, so the
+    // list must be executed before the next draw()
+    void draw(DrawList& list, const Camera& camera, b2Vec2 mask_position);
 
     bool isLoaded() const { return loaded_; }
 
@@ -20,14 +24,15 @@ public:
     float worldWidth() const { return world_width_; }
 
 private:
-    struct BraillePixel {
-        int dx; // braille pixel offset from center
-        int dy;
-    };
-
-    std::vector<BraillePixel> pixels_;
-    int braille_width_ = 0;  // image width in braille pixels
-    int braille_height_ = 0; // image height in braille pixels
+    void buildSprite(float pixels_per_meter);
+
+    // Source image, thresholded to opaque/transparent
+    std::vector<uint8_t> opaque_;
+    int image_width_ = 0;
+    int image_height_ = 0;
+
+    PixelSprite sprite_;               // Opaque image pixels at canvas resolution
+    float sprite_pixels_per_meter_ = 0.0f;
     float world_width_ = 0.6f;
     bool loaded_ = false;
 };
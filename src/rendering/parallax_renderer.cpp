@@ -0,0 +1,51 @@
+#include "rendering/parallax_renderer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void ParallaxRenderer::draw(DrawList& list, const Camera& camera) {
+    const float ppm = camera.basePixelsPerMeter();
+    const b2Vec2 focus = camera.focus();
+
+    // Stars: hashed per block, barely moving
+    StarField stars;
+    stars.seed = STAR_SEED;
+    stars.cell = STAR_CELL;
+    stars.offset_x = static_cast<int>(std::floor(focus.x * ppm * STAR_FACTOR));
+    stars.offset_y = static_cast<int>(std::floor(-focus.y * ppm * STAR_FACTOR));
+    stars.density = STAR_DENSITY;
+    list.starField(stars, camera.screenHeight());
+
+    // Hills: one pre-rasterized tile repeated across the screen
+    if (ppm != hills_pixels_per_meter_) {
+        buildHills(ppm);
+    }
+    int scroll_x = static_cast<int>(std::floor(focus.x * ppm * HILL_FACTOR));
+    list.tiled(hills_, scroll_x, static_cast<int>(camera.screenHeight() * HILL_TOP));
+}
+
+void ParallaxRenderer::buildHills(float pixels_per_meter) {
+    int height = std::max(1, static_cast<int>(HILL_HEIGHT * pixels_per_meter));
+    hills_.resize(HILL_TILE_WIDTH, height);
+
+    // Whole-period sines so the tile wraps seamlessly
+    auto ridge = [&](int x) {
+        float t = 2.0f * static_cast<float>(M_PI) * x / HILL_TILE_WIDTH;
+        float h = 0.5f + 0.25f * std::sin(2.0f * t) + 0.15f * std::sin(5.0f * t + 1.3f) +
+                  0.08f * std::sin(11.0f * t + 0.4f);
+        return std::clamp(static_cast<int>((1.0f - h) * (height - 1)), 0, height - 1);
+    };
+
+    // Join each column to the previous one so steep slopes stay connected
+    int previous = ridge(HILL_TILE_WIDTH - 1);
+    for (int x = 0; x < HILL_TILE_WIDTH; ++x) {
+        int y = ridge(x);
+        int y0 = std::min(y, previous + (y > previous ? 1 : 0));
+        int y1 = std::max(y, previous - (y < previous ? 1 : 0));
+        for (int py = y0; py <= y1; ++py) {
+            hills_.set(x, py);
+        }
+        previous = y;
+    }
+    hills_pixels_per_meter_ = pixels_per_meter;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "rendering/camera.hpp"
+#include "rendering/draw_list.hpp"
+#include "rendering/pixel_canvas.hpp"
+
+// Background layers behind the terrain: a hashed star field and a tiled
+// range of distant hills. Layers scroll at their parallax factor but
+// ignore zoom, since they are far away. Each is one DrawList command that
+// ORs whole words into the canvas.
+class ParallaxRenderer {
+public:
+    // The hill tile is rebuilt when the camera's base pixel density
+    // changes, so the list must be executed before the next draw()
+    void draw(DrawList& list, const Camera& camera);
+
+private:
+    static constexpr float STAR_FACTOR = 0.05f;
+    static constexpr int STAR_CELL = 10;          // Pixels per star block
+    static constexpr uint32_t STAR_DENSITY = 9000; // Out of 65536 blocks
+    static constexpr uint32_t STAR_SEED = 0x5EED57A5u;
+
+    static constexpr float HILL_FACTOR = 0.25f;
+    static constexpr int HILL_TILE_WIDTH = 512;   // Pixels; a multiple of 64
+    static constexpr float HILL_HEIGHT = 3.0f;    // Meters of tile height
+    static constexpr float HILL_TOP = 0.3f;       // Tile top, fraction of screen height
+
+    void buildHills(float pixels_per_meter);
+
+    PixelSprite hills_;
+    float hills_pixels_per_meter_ = 0.0f;
+};
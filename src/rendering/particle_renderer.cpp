@@ -0,0 +1,26 @@
+#include "rendering/particle_renderer.hpp"
+
+#include <algorithm>
+
+void ParticleRenderer::draw(DrawList& list, const Camera& camera,
+                            const std::vector<b2Vec2>& dust,
+                            const std::vector<b2Vec2>& streaks,
+                            float speed) {
+    points_.clear();
+    for (const auto& p : dust) {
+        Camera::ScreenPos s = camera.worldToScreen(p);
+        points_.push_back({s.x, s.y});
+    }
+    list.points(points_.data(), static_cast<int>(points_.size()));
+
+    // Streaks trail to the right, where the ball has come from
+    int length = std::min(STREAK_MAX_LENGTH,
+                          static_cast<int>(speed * STREAK_BLUR * camera.pixelsPerMeter()));
+    if (length <= 0) {
+        return;
+    }
+    for (const auto& p : streaks) {
+        Camera::ScreenPos s = camera.worldToScreen(p);
+        list.span(s.y, s.x, s.x + length);
+    }
+}
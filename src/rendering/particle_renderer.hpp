@@ -0,0 +1,25 @@
+#pragma once
+
+#include "rendering/camera.hpp"
+#include "rendering/draw_list.hpp"
+
+#include <box2d/box2d.h>
+
+#include <vector>
+
+// Draws particle positions copied out of a ParticleSystem: dust as a
+// single point batch, streaks as short horizontal blur lines whose length
+// follows the ball's speed.
+class ParticleRenderer {
+public:
+    void draw(DrawList& list, const Camera& camera,
+              const std::vector<b2Vec2>& dust,
+              const std::vector<b2Vec2>& streaks,
+              float speed);
+
+private:
+    static constexpr float STREAK_BLUR = 0.04f;  // Seconds of travel per streak
+    static constexpr int STREAK_MAX_LENGTH = 64; // Pixels
+
+    std::vector<DrawList::Point> points_; // Scratch, keeps its capacity
+};
@@ -0,0 +1,339 @@
+#include "rendering/pixel_canvas.hpp"
+#include "rendering/spatial_hash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+
+namespace {
+
+constexpr int WORD_BITS = 64;
+
+int wordsFor(int width) {
+    return (width + WORD_BITS - 1) / WORD_BITS;
+}
+
+int floorDiv(int a, int b) {
+    return a / b - (a % b != 0 && (a < 0) != (b < 0));
+}
+
+// Checkerboard rows for dithered fills
+uint64_t ditherPattern(int y, bool dither) {
+    if (!dither) {
+        return ~uint64_t{0};
+    }
+    return (y & 1) ? 0xAAAAAAAAAAAAAAAAull : 0x5555555555555555ull;
+}
+
+} // namespace
+
+void PixelSprite::resize(int w, int h) {
+    width = w;
+    height = h;
+    stride = wordsFor(w);
+    bits.assign(static_cast<size_t>(stride) * h, 0);
+}
+
+void PixelSprite::set(int x, int y) {
+    bits[static_cast<size_t>(y) * stride + x / WORD_BITS] |= uint64_t{1} << (x % WORD_BITS);
+}
+
+void PixelCanvas::resize(int width, int height, int cell_width, int cell_height) {
+    width_ = std::max(0, width);
+    height_ = std::max(0, height);
+    stride_ = wordsFor(width_);
+    cell_pixel_width_ = std::clamp(cell_width, 1, MAX_CELL_WIDTH);
+    cell_pixel_height_ = std::clamp(cell_height, 1, MAX_CELL_HEIGHT);
+    cell_width_ = (width_ + cell_pixel_width_ - 1) / cell_pixel_width_;
+    cell_height_ = (height_ + cell_pixel_height_ - 1) / cell_pixel_height_;
+
+    // Cover whole cell rows so a partial bottom cell can be read safely
+    bits_.resize(static_cast<size_t>(stride_) * cell_height_ * cell_pixel_height_);
+    inks_.resize(static_cast<size_t>(cell_width_) * cell_height_);
+}
+
+void PixelCanvas::clear() {
+    std::fill(bits_.begin(), bits_.end(), 0);
+    std::fill(inks_.begin(), inks_.end(), Ink::Default);
+}
+
+uint8_t PixelCanvas::cellMask(int cx, int cy) const {
+    // Cell widths divide the word size, so a cell never straddles words
+    int x = cx * cell_pixel_width_;
+    int word = x / WORD_BITS;
+    int shift = x % WORD_BITS;
+    int y = cy * cell_pixel_height_;
+    uint64_t columns = (uint64_t{1} << cell_pixel_width_) - 1;
+
+    uint8_t mask = 0;
+    for (int dy = 0; dy < cell_pixel_height_; ++dy) {
+        mask |= static_cast<uint8_t>(((row(y + dy)[word] >> shift) & columns)
+                                     << (dy * cell_pixel_width_));
+    }
+    return mask;
+}
+
+RasterBand::RasterBand(PixelCanvas& canvas, int y_begin, int y_end)
+    : canvas_(canvas),
+      y_begin_(std::max(0, y_begin)),
+      y_end_(std::min(canvas.height(), y_end)) {}
+
+void RasterBand::setPixel(int x, int y) {
+    if (x < 0 || x >= canvas_.width() || y < y_begin_ || y >= y_end_) {
+        return;
+    }
+    canvas_.row(y)[x / WORD_BITS] |= uint64_t{1} << (x % WORD_BITS);
+}
+
+void RasterBand::setInk(int x, int y, Ink ink) {
+    if (x < 0 || x >= canvas_.width() || y < y_begin_ || y >= y_end_) {
+        return;
+    }
+    canvas_.setInk(x / canvas_.cellPixelWidth(), y / canvas_.cellPixelHeight(), ink);
+}
+
+void RasterBand::drawLine(int x0, int y0, int x1, int y1) {
+    // Skip lines that miss this band entirely
+    if (std::max(y0, y1) < y_begin_ || std::min(y0, y1) >= y_end_) {
+        return;
+    }
+    if (std::max(x0, x1) < 0 || std::min(x0, x1) >= canvas_.width()) {
+        return;
+    }
+
+    const int dx = std::abs(x1 - x0);
+    const int dy = std::abs(y1 - y0);
+    const int sx = x0 < x1 ? 1 : -1;
+    const int sy = y0 < y1 ? 1 : -1;
+    int error = dx - dy;
+
+    while (true) {
+        setPixel(x0, y0);
+        if (x0 == x1 && y0 == y1) {
+            break;
+        }
+        int e2 = 2 * error;
+        if (e2 >= -dy) {
+            error -= dy;
+            x0 += sx;
+        }
+        if (e2 <= dx) {
+            error += dx;
+            y0 += sy;
+        }
+    }
+}
+
+void RasterBand::plotPoints(const Point* points, int count) {
+    const int width = canvas_.width();
+    for (int i = 0; i < count; ++i) {
+        int x = points[i].x;
+        int y = points[i].y;
+        if (x < 0 || x >= width || y < y_begin_ || y >= y_end_) {
+            continue;
+        }
+        canvas_.row(y)[x / WORD_BITS] |= uint64_t{1} << (x % WORD_BITS);
+    }
+}
+
+void RasterBand::fillSpan(int y, int x0, int x1) {
+    if (y < y_begin_ || y >= y_end_) {
+        return;
+    }
+    if (x0 > x1) {
+        std::swap(x0, x1);
+    }
+    x0 = std::max(x0, 0);
+    x1 = std::min(x1, canvas_.width() - 1);
+    if (x0 > x1) {
+        return;
+    }
+
+    uint64_t* row = canvas_.row(y);
+    int w0 = x0 / WORD_BITS;
+    int w1 = x1 / WORD_BITS;
+    uint64_t head = ~uint64_t{0} << (x0 % WORD_BITS);
+    uint64_t tail = ~uint64_t{0} >> (WORD_BITS - 1 - x1 % WORD_BITS);
+
+    if (w0 == w1) {
+        row[w0] |= head & tail;
+        return;
+    }
+    row[w0] |= head;
+    for (int w = w0 + 1; w < w1; ++w) {
+        row[w] = ~uint64_t{0};
+    }
+    row[w1] |= tail;
+}
+
+void RasterBand::fillEvenOdd(const Edge* edges, int count) {
+    if (count < 2) {
+        return;
+    }
+
+    int y_min = edges[0].y0, y_max = edges[0].y0;
+    for (int e = 0; e < count; ++e) {
+        y_min = std::min({y_min, edges[e].y0, edges[e].y1});
+        y_max = std::max({y_max, edges[e].y0, edges[e].y1});
+    }
+    y_min = std::max(y_min, y_begin_);
+    y_max = std::min(y_max, y_end_);
+
+    // Edges cover the half-open range [y_lo, y_hi) so shared vertices are
+    // never counted twice. Fill shapes are small, so crossings are few.
+    constexpr int MAX_CROSSINGS = 64;
+    std::array<int, MAX_CROSSINGS> crossings;
+    for (int y = y_min; y < y_max; ++y) {
+        int n = 0;
+        for (int e = 0; e < count && n < MAX_CROSSINGS; ++e) {
+            const Edge& edge = edges[e];
+            if ((edge.y0 <= y) == (edge.y1 <= y)) {
+                continue;
+            }
+
+            float t = static_cast<float>(y - edge.y0) / (edge.y1 - edge.y0);
+            int x = static_cast<int>(edge.x0 + t * (edge.x1 - edge.x0));
+
+            int j = n++;
+            while (j > 0 && crossings[j - 1] > x) {
+                crossings[j] = crossings[j - 1];
+                --j;
+            }
+            crossings[j] = x;
+        }
+
+        for (int k = 0; k + 1 < n; k += 2) {
+            fillSpan(y, crossings[k], crossings[k + 1]);
+        }
+    }
+}
+
+void RasterBand::fillBelow(const int* surface, int x0, int count, bool dither) {
+    int x_begin = std::max(x0, 0);
+    int x_end = std::min(x0 + count, canvas_.width());
+
+    for (int w = x_begin / WORD_BITS; x_begin < x_end && w * WORD_BITS < x_end; ++w) {
+        int cx0 = std::max(x_begin, w * WORD_BITS);
+        int cx1 = std::min(x_end, (w + 1) * WORD_BITS);
+
+        // Surface range over this word's columns
+        int top = surface[cx0 - x0], bottom = top;
+        for (int x = cx0 + 1; x < cx1; ++x) {
+            top = std::min(top, surface[x - x0]);
+            bottom = std::max(bottom, surface[x - x0]);
+        }
+        uint64_t columns = (~uint64_t{0} << (cx0 % WORD_BITS)) &
+                           (~uint64_t{0} >> (WORD_BITS - 1 - (cx1 - 1) % WORD_BITS));
+
+        // Rows the surface crosses are set column by column; rows below
+        // its lowest point are set as one word
+        int y = std::max(top, y_begin_);
+        for (; y < std::min(bottom, y_end_); ++y) {
+            uint64_t bits = 0;
+            for (int x = cx0; x < cx1; ++x) {
+                if (surface[x - x0] <= y) {
+                    bits |= uint64_t{1} << (x % WORD_BITS);
+                }
+            }
+            canvas_.row(y)[w] |= bits & ditherPattern(y, dither);
+        }
+        for (; y < y_end_; ++y) {
+            canvas_.row(y)[w] |= columns & ditherPattern(y, dither);
+        }
+    }
+}
+
+void RasterBand::blit(const PixelSprite& sprite, int x, int y, Ink ink) {
+    int row_begin = std::max(y, y_begin_);
+    int row_end = std::min(y + sprite.height, y_end_);
+    int stride = canvas_.stride();
+
+    for (int py = row_begin; py < row_end; ++py) {
+        const uint64_t* src = sprite.row(py - y);
+        uint64_t* dst = canvas_.row(py);
+
+        for (int w = 0; w < sprite.stride; ++w) {
+            uint64_t bits = src[w];
+            int dst_x = x + w * WORD_BITS;
+            if (dst_x < 0) {
+                if (dst_x <= -WORD_BITS) {
+                    continue;
+                }
+                bits >>= -dst_x;
+                dst_x = 0;
+            }
+            if (bits == 0 || dst_x >= canvas_.width()) {
+                continue;
+            }
+
+            int word = dst_x / WORD_BITS;
+            int shift = dst_x % WORD_BITS;
+            dst[word] |= bits << shift;
+            if (shift != 0 && word + 1 < stride) {
+                dst[word + 1] |= bits >> (WORD_BITS - shift);
+            }
+
+            if (ink == Ink::Default) {
+                continue;
+            }
+            while (bits != 0) {
+                int bit = __builtin_ctzll(bits);
+                bits &= bits - 1;
+                setInk(dst_x + bit, py, ink);
+            }
+        }
+    }
+}
+
+void RasterBand::blitTiled(const PixelSprite& tile, int scroll_x, int y) {
+    if (tile.stride == 0) {
+        return;
+    }
+    int row_begin = std::max(y, y_begin_);
+    int row_end = std::min(y + tile.height, y_end_);
+    int period = tile.stride * WORD_BITS;
+    int start = ((scroll_x % period) + period) % period;
+    int stride = canvas_.stride();
+    int tail_bits = canvas_.width() % WORD_BITS;
+    uint64_t tail = tail_bits == 0 ? ~uint64_t{0} : (uint64_t{1} << tail_bits) - 1;
+
+    for (int py = row_begin; py < row_end; ++py) {
+        const uint64_t* src = tile.row(py - y);
+        uint64_t* dst = canvas_.row(py);
+
+        int word = start / WORD_BITS;
+        int shift = start % WORD_BITS;
+        for (int w = 0; w < stride; ++w) {
+            int next = word + 1 == tile.stride ? 0 : word + 1;
+            uint64_t bits = shift == 0
+                ? src[word]
+                : (src[word] >> shift) | (src[next] << (WORD_BITS - shift));
+            dst[w] |= w + 1 == stride ? bits & tail : bits;
+            word = next;
+        }
+    }
+}
+
+void RasterBand::starField(const StarField& field) {
+    if (field.cell <= 0 || field.density == 0) {
+        return;
+    }
+
+    // Blocks whose rows can reach this band
+    int block_y0 = floorDiv(y_begin_ + field.offset_y, field.cell);
+    int block_y1 = floorDiv(y_end_ - 1 + field.offset_y, field.cell);
+    int block_x0 = floorDiv(field.offset_x, field.cell);
+    int block_x1 = floorDiv(canvas_.width() - 1 + field.offset_x, field.cell);
+
+    for (int by = block_y0; by <= block_y1; ++by) {
+        for (int bx = block_x0; bx <= block_x1; ++bx) {
+            uint32_t h = spatialHash(bx, by, field.seed);
+            if ((h & 0xFFFF) >= field.density) {
+                continue;
+            }
+            int x = bx * field.cell + static_cast<int>((h >> 16) & 0xFF) % field.cell;
+            int y = by * field.cell + static_cast<int>(h >> 24) % field.cell;
+            setPixel(x - field.offset_x, y - field.offset_y);
+        }
+    }
+}
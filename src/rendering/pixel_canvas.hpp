@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Ink used for a character cell when the canvas is written to the terminal
+enum class Ink : uint8_t {
+    Default,
+    Mask,
+};
+
+// 1-bit sprite stored as packed rows, same layout as PixelCanvas rows
+struct PixelSprite {
+    int width = 0;
+    int height = 0;
+    int stride = 0; // 64-bit words per row
+    std::vector<uint64_t> bits;
+
+    void resize(int w, int h);
+    void set(int x, int y);
+    const uint64_t* row(int y) const { return &bits[static_cast<size_t>(y) * stride]; }
+};
+
+// Procedural star field: at most one star per cell x cell block of layer
+// space, placed by hashing the block coordinates, so nothing is stored per
+// star. Layer pixel (x, y) lands on canvas pixel (x - offset_x, y - offset_y).
+struct StarField {
+    uint32_t seed = 0;
+    int cell = 8;
+    int offset_x = 0;
+    int offset_y = 0;
+    uint32_t density = 0; // Chance of a star per block, out of 65536
+};
+
+// Packed sub-pixel bitplane. Each pixel row is a run of 64-bit words so
+// spans and layers can be written a word at a time. Pixels are grouped
+// into character cells of up to 2x4 (braille and octants use 2x4, half
+// blocks 1x2); ink is tracked per cell.
+class PixelCanvas {
+public:
+    static constexpr int MAX_CELL_WIDTH = 2;
+    static constexpr int MAX_CELL_HEIGHT = 4;
+
+    // Size in pixels; storage is kept when shrinking
+    void resize(int width, int height,
+                int cell_width = MAX_CELL_WIDTH, int cell_height = MAX_CELL_HEIGHT);
+    void clear();
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+    int stride() const { return stride_; }
+    int cellWidth() const { return cell_width_; }
+    int cellHeight() const { return cell_height_; }
+    int cellPixelWidth() const { return cell_pixel_width_; }
+    int cellPixelHeight() const { return cell_pixel_height_; }
+
+    uint64_t* row(int y) { return &bits_[static_cast<size_t>(y) * stride_]; }
+    const uint64_t* row(int y) const { return &bits_[static_cast<size_t>(y) * stride_]; }
+
+    Ink ink(int cx, int cy) const { return inks_[static_cast<size_t>(cy) * cell_width_ + cx]; }
+    void setInk(int cx, int cy, Ink ink) { inks_[static_cast<size_t>(cy) * cell_width_ + cx] = ink; }
+
+    // Pixels of a cell, row-major: bit (y * cellPixelWidth() + x)
+    uint8_t cellMask(int cx, int cy) const;
+
+private:
+    int width_ = 0;
+    int height_ = 0;
+    int stride_ = 0;
+    int cell_width_ = 0;
+    int cell_height_ = 0;
+    int cell_pixel_width_ = MAX_CELL_WIDTH;
+    int cell_pixel_height_ = MAX_CELL_HEIGHT;
+    std::vector<uint64_t> bits_;
+    std::vector<Ink> inks_;
+};
+
+// Drawing operations clipped to the rows [y_begin, y_end) of a canvas.
+// Bands over disjoint rows touch disjoint memory, so they can be drawn
+// from different threads.
+class RasterBand {
+public:
+    struct Edge {
+        int x0, y0, x1, y1;
+    };
+
+    struct Point {
+        int x, y;
+    };
+
+    RasterBand(PixelCanvas& canvas, int y_begin, int y_end);
+
+    int top() const { return y_begin_; }
+    int bottom() const { return y_end_; }
+
+    void setPixel(int x, int y);
+    void setInk(int x, int y, Ink ink);
+
+    // Bresenham line, endpoints inclusive
+    void drawLine(int x0, int y0, int x1, int y1);
+
+    // Horizontal span, endpoints inclusive
+    void fillSpan(int y, int x0, int x1);
+
+    // Set a batch of pixels; points outside the band are skipped
+    void plotPoints(const Point* points, int count);
+
+    // Even-odd scanline fill of a closed edge set
+    void fillEvenOdd(const Edge* edges, int count);
+
+    // Fill every column x in [x0, x0 + count) from surface[x - x0] down,
+    // a whole word of columns per row where possible. Dithered fills set
+    // a checkerboard instead.
+    void fillBelow(const int* surface, int x0, int count, bool dither);
+
+    // OR a sprite in with its top-left corner at (x, y)
+    void blit(const PixelSprite& sprite, int x, int y, Ink ink);
+
+    // OR a sprite repeated across the full width, scrolled left by scroll_x
+    // pixels, with its top at row y. The sprite width must be a multiple
+    // of 64 so each destination word is one funnel shift of two source words.
+    void blitTiled(const PixelSprite& tile, int scroll_x, int y);
+
+    void starField(const StarField& field);
+
+private:
+    PixelCanvas& canvas_;
+    int y_begin_;
+    int y_end_;
+};
@@ -0,0 +1,66 @@
+#include "rendering/pixel_canvas_element.hpp"
+
+#include <ftxui/dom/node.hpp>
+#include <ftxui/screen/screen.hpp>
+
+#include <algorithm>
+
+namespace {
+
+ftxui::Color inkColor(Ink ink) {
+    switch (ink) {
+        case Ink::Mask:    return ftxui::Color::Orange1;
+        case Ink::Default: break;
+    }
+    return ftxui::Color::Default;
+}
+
+class PixelCanvasNode : public ftxui::Node {
+public:
+    PixelCanvasNode(const PixelCanvas& canvas, const CellEncoder& encoder, bool ink_color)
+        : canvas_(canvas), encoder_(encoder), ink_color_(ink_color) {}
+
+    // No minimum size: the canvas is sized by the layout (use with flex)
+    // and cells beyond the box are clipped
+    void ComputeRequirement() override {
+        requirement_.min_x = 0;
+        requirement_.min_y = 0;
+    }
+
+    void Render(ftxui::Screen& screen) override {
+        int cols = std::min(canvas_.cellWidth(), box_.x_max - box_.x_min + 1);
+        int rows = std::min(canvas_.cellHeight(), box_.y_max - box_.y_min + 1);
+
+        for (int cy = 0; cy < rows; ++cy) {
+            for (int cx = 0; cx < cols; ++cx) {
+                uint8_t mask = canvas_.cellMask(cx, cy);
+                if (mask == 0) {
+                    continue;
+                }
+
+                auto& pixel = screen.PixelAt(box_.x_min + cx, box_.y_min + cy);
+                pixel.character = encoder_.glyph(mask);
+
+                if (!ink_color_) {
+                    continue;
+                }
+                Ink ink = canvas_.ink(cx, cy);
+                if (ink != Ink::Default) {
+                    pixel.foreground_color = inkColor(ink);
+                }
+            }
+        }
+    }
+
+private:
+    const PixelCanvas& canvas_;
+    const CellEncoder& encoder_;
+    bool ink_color_;
+};
+
+} // namespace
+
+ftxui::Element pixelCanvasElement(const PixelCanvas& canvas, const CellEncoder& encoder,
+                                  bool ink_color) {
+    return std::make_shared<PixelCanvasNode>(canvas, encoder, ink_color);
+}
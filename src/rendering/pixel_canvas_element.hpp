@@ -0,0 +1,13 @@
+#pragma once
+
+#include "rendering/cell_encoder.hpp"
+#include "rendering/pixel_canvas.hpp"
+
+#include <ftxui/dom/elements.hpp>
+
+// FTXUI element that writes a PixelCanvas into the screen, one glyph per
+// cell from the encoder's table. The canvas must have been sized with the
+// encoder's cell size, and is borrowed until the frame is rendered. With
+// ink_color off every cell keeps the default color.
+ftxui::Element pixelCanvasElement(const PixelCanvas& canvas, const CellEncoder& encoder,
+                                  bool ink_color = true);
@@ -1,19 +1,205 @@
 #include "rendering/renderer.hpp"
-#include "physics/softbody_ball.hpp"
+#include "rendering/pixel_canvas_element.hpp"
+#include "game/game_session.hpp"
+#include "diagnostics/memory_tags.hpp"
+#include "diagnostics/profiler.hpp"
+#include "diagnostics/trace.hpp"
 
-#include <ftxui/dom/canvas.hpp>
+#include <algorithm>
+#include <utility>
 
-Renderer::Renderer() = default;
+Renderer::Renderer(const std::string& mask_image_path)
+    : mask_renderer_(mask_image_path) {
+    render_thread_ = std::thread(&Renderer::renderLoop, this);
+}
+
+Renderer::~Renderer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_one();
+    render_thread_.join();
+}
+
+uint64_t Renderer::submitFrame(const GameSession& session, bool debug, int columns, int rows) {
+    MEMORY_SCOPE(Renderer);
+    // PIXELS_PER_METER is per braille pixel (two per column); keep the same
+    // world width per column whatever the cell size
+    const CellEncoder& encoder = CellEncoder::get(cell_encoding_);
+    camera_.setBasePixelsPerMeter(Camera::PIXELS_PER_METER * encoder.cellWidth() / 2.0f);
+    camera_.setScreenSize(columns * encoder.cellWidth(), rows * encoder.cellHeight());
+
+    FrameSnapshot& frame = staging_;
+    frame.frame_id = ++next_frame_id_;
+    frame.camera = camera_;
+    frame.cell_encoding = cell_encoding_;
+    frame.terrain_fill = terrain_fill_;
+    frame.background = background_;
+    frame.debug = debug;
+    frame.core_position = session.ball().getCenterPosition();
+    frame.speed = session.ball().getSpeed();
+    session.ball().getRimPositions(frame.rim_positions);
+    frame.mask_position = session.mask().getPosition();
+
+    // Copy only the particles inside the viewport
+    frame.dust.clear();
+    frame.streaks.clear();
+    const ParticleSystem& particles = session.particles();
+    for (int i = 0; i < particles.size(); ++i) {
+        b2Vec2 p = {particles.x(i), particles.y(i)};
+        if (p.x < camera_.viewportLeft() || p.x > camera_.viewportRight()) {
+            continue;
+        }
+        auto& out = particles.kind(i) == ParticleSystem::Kind::Dust ? frame.dust : frame.streaks;
+        out.push_back(p);
+    }
+
+    // Coarsest terrain LOD that still has a vertex about every column
+    const int lod = TerrainRenderer::lodLevel(encoder.cellWidth() / camera_.pixelsPerMeter()) +
+                    (half_res_terrain_ ? 1 : 0);
+
+    // Copy only the terrain inside the viewport; segments run left to right
+    frame.terrain_points.clear();
+    frame.terrain_runs.clear();
+    const auto& segments = session.segments();
+    auto first = std::partition_point(segments.begin(), segments.end(),
+        [&](const LevelSegment& s) { return s.end_x < camera_.viewportLeft(); });
+    for (auto segment = first; segment != segments.end(); ++segment) {
+        if (segment->start_x > camera_.viewportRight()) {
+            break;
+        }
+
+        FrameSnapshot::TerrainRun run;
+        run.first = static_cast<uint32_t>(frame.terrain_points.size());
+        run.is_goal = segment->is_goal;
+        run.goal_x = segment->end_x;
+
+        const auto& points = segment->pointsAtLevel(lod);
+        frame.terrain_points.insert(frame.terrain_points.end(), points.begin(), points.end());
+        run.count = static_cast<uint32_t>(frame.terrain_points.size()) - run.first;
+        frame.terrain_runs.push_back(run);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::swap(staging_, pending_);
+        if (pending_fresh_) {
+            frames_dropped_++;
+        }
+        pending_fresh_ = true;
+    }
+    cv_.notify_one();
+    return next_frame_id_;
+}
+
+void Renderer::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [this] { return !pending_fresh_ && !rendering_; });
+}
+
+ftxui::Element Renderer::gameCanvas() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (ready_fresh_) {
+            std::swap(front_, ready_);
+            ready_fresh_ = false;
+        }
+    }
+    shown_frame_id_ = canvas_frame_ids_[front_];
+    return pixelCanvasElement(canvases_[front_], CellEncoder::get(canvas_encodings_[front_]),
+                              mask_color_);
+}
+
+void Renderer::renderLoop() {
+    TRACE_THREAD_NAME("render");
+    MEMORY_SCOPE(Renderer);
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        cv_.wait(lock, [this] { return stopping_ || pending_fresh_; });
+        if (stopping_) {
+            return;
+        }
+
+        std::swap(pending_, working_);
+        pending_fresh_ = false;
+        rendering_ = true;
+        const int back = back_;
+        PixelCanvas& canvas = canvases_[back];
+        lock.unlock();
+
+        record(working_);
+        const CellEncoder& encoder = CellEncoder::get(working_.cell_encoding);
+        canvas.resize(working_.camera.screenWidth(), working_.camera.screenHeight(),
+                      encoder.cellWidth(), encoder.cellHeight());
+        canvas_encodings_[back] = working_.cell_encoding;
+        canvas_frame_ids_[back] = working_.frame_id;
+        {
+            PROFILE_SCOPE(Raster);
+            rasterizer_.rasterize(draw_list_, canvas);
+        }
+
+        lock.lock();
+        std::swap(back_, ready_);
+        if (ready_fresh_) {
+            frames_dropped_++; // Finished frame was never shown
+        }
+        ready_fresh_ = true;
+        rendering_ = false;
+        idle_cv_.notify_all();
+        if (frame_ready_) {
+            frame_ready_();
+        }
+    }
+}
+
+void Renderer::record(const FrameSnapshot& frame) {
+    const Camera& camera = frame.camera;
+    draw_list_.clear();
+
+    // Background layers
+    if (frame.background) {
+        PROFILE_SCOPE(Parallax);
+        parallax_renderer_.draw(draw_list_, camera);
+    }
+    {
+        PROFILE_SCOPE(Particles);
+        particle_renderer_.draw(draw_list_, camera, frame.dust, frame.streaks, frame.speed);
+    }
 
-ftxui::Element Renderer::render(const SoftbodyBall& ball,
-                                 int screen_width,
-                                 int screen_height) {
-    using namespace ftxui;
+    // Draw terrain
+    {
+        PROFILE_SCOPE(Terrain);
+        for (const auto& run : frame.terrain_runs) {
+            const b2Vec2* points = frame.terrain_points.data() + run.first;
+            if (frame.terrain_fill == TerrainFill::Outline) {
+                terrain_renderer_.drawPolyline(draw_list_, camera, points, run.count);
+            } else {
+                terrain_renderer_.drawFilled(draw_list_, camera, points, run.count,
+                                             frame.terrain_fill);
+            }
+            if (run.is_goal) {
+                terrain_renderer_.drawGoalPosts(draw_list_, camera, run.goal_x);
+            }
+        }
+    }
 
-    camera_.setScreenSize(screen_width, screen_height);
+    // Draw ball
+    {
+        PROFILE_SCOPE(Ball);
+        if (frame.debug) {
+            ball_renderer_.drawDebug(draw_list_, camera,
+                                     frame.core_position,
+                                     frame.rim_positions,
+                                     SoftbodyBall::CORE_RADIUS,
+                                     SoftbodyBall::RIM_CIRCLE_RADIUS);
+        } else {
+            ball_renderer_.draw(draw_list_, camera, frame.core_position, frame.rim_positions);
+        }
+    }
 
-    return canvas(screen_width / 2, screen_height / 4, [&](Canvas& c) {
-        // Draw the ball
-        ball_renderer_.draw(c, camera_, ball.getCenterPosition(), ball.getRimPositions());
-    });
+    // Draw mask overlay
+    PROFILE_SCOPE(Mask);
+    mask_renderer_.draw(draw_list_, camera, frame.mask_position);
 }
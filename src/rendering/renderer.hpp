@@ -1,28 +1,123 @@
 #pragma once
 
 #include "rendering/camera.hpp"
+#include "rendering/cell_encoder.hpp"
+#include "rendering/draw_list.hpp"
+#include "rendering/pixel_canvas.hpp"
+#include "rendering/band_rasterizer.hpp"
+#include "rendering/frame_snapshot.hpp"
+#include "rendering/terrain_renderer.hpp"
 #include "rendering/ball_renderer.hpp"
+#include "rendering/mask_renderer.hpp"
+#include "rendering/parallax_renderer.hpp"
+#include "rendering/particle_renderer.hpp"
 
 #include <ftxui/dom/elements.hpp>
 
-#include <box2d/box2d.h>
-#include <vector>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
 
-// Forward declarations
-class SoftbodyBall;
+class GameSession;
 
+// Two-stage frame pipeline. The main thread copies each simulated frame
+// into a FrameSnapshot and submits it; a render thread records and
+// rasterizes it while the main thread moves on to the next step. The UI
+// always shows the newest finished canvas. Frames are dropped, never
+// queued, when either side falls behind.
 class Renderer {
 public:
-    Renderer();
+    explicit Renderer(const std::string& mask_image_path);
+    ~Renderer();
 
-    // Render the game world to an FTXUI element
-    ftxui::Element render(const SoftbodyBall& ball,
-                          int screen_width,
-                          int screen_height);
+    // Capture the drawable state of the session (view size in character
+    // cells) and hand it to the render thread. A submitted frame that has
+    // not started rendering yet is replaced. Returns the frame's id.
+    uint64_t submitFrame(const GameSession& session, bool debug, int columns, int rows);
+
+    // Called on the render thread each time a frame is ready to show. Set
+    // before the first submitFrame().
+    void setFrameReadyCallback(std::function<void()> callback) {
+        frame_ready_ = std::move(callback);
+    }
+
+    // Block until every submitted frame has been rendered (benchmarks)
+    void waitIdle();
+
+    // Element showing the newest finished frame. Main thread only; the
+    // canvas stays valid until the next call.
+    ftxui::Element gameCanvas();
+    // Id of the frame in the last gameCanvas() (0 before the first)
+    uint64_t shownFrameId() const { return shown_frame_id_; }
+
+    // Glyphs used for canvas cells; takes effect from the next submitted
+    // frame. Main thread only.
+    void setCellEncoding(CellEncoding encoding) { cell_encoding_ = encoding; }
+    CellEncoding cellEncoding() const { return cell_encoding_; }
+
+    // How the ground is drawn; main thread only
+    void setTerrainFill(TerrainFill fill) { terrain_fill_ = fill; }
+    // Parallax stars and hills; main thread only
+    void setBackground(bool enabled) { background_ = enabled; }
+
+    // Quality trade-offs for slow terminals. Main thread only.
+    void setMaskColor(bool enabled) { mask_color_ = enabled; }
+    void setHalfResTerrain(bool enabled) { half_res_terrain_ = enabled; }
 
     Camera& camera() { return camera_; }
+    const MaskRenderer& maskRenderer() const { return mask_renderer_; }
+
+    // Frames that were replaced before being rendered or shown
+    uint64_t framesDropped() const { return frames_dropped_.load(); }
 
 private:
+    void renderLoop();
+    void record(const FrameSnapshot& frame);
+
     Camera camera_;
+    MaskRenderer mask_renderer_;
+    uint64_t next_frame_id_ = 0;
+    CellEncoding cell_encoding_ = CellEncoding::Braille;
+    TerrainFill terrain_fill_ = TerrainFill::Outline;
+    bool background_ = true;
+    bool mask_color_ = true;
+    bool half_res_terrain_ = false;
+
+    // Snapshot mailbox: staging (main thread) -> pending -> working (render thread)
+    FrameSnapshot staging_;
+    FrameSnapshot pending_;
+    FrameSnapshot working_;
+    bool pending_fresh_ = false;
+
+    // Render thread state
+    ParallaxRenderer parallax_renderer_;
+    TerrainRenderer terrain_renderer_;
     BallRenderer ball_renderer_;
+    ParticleRenderer particle_renderer_;
+    DrawList draw_list_;
+    BandRasterizer rasterizer_;
+
+    // Triple-buffered output: back (rendering), ready (newest), front (shown)
+    std::array<PixelCanvas, 3> canvases_;
+    std::array<CellEncoding, 3> canvas_encodings_{};
+    std::array<uint64_t, 3> canvas_frame_ids_{};
+    uint64_t shown_frame_id_ = 0;
+    int back_ = 0;
+    int ready_ = 1;
+    int front_ = 2;
+    bool ready_fresh_ = false;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::condition_variable idle_cv_;
+    bool rendering_ = false;
+    bool stopping_ = false;
+    std::atomic<uint64_t> frames_dropped_{0};
+    std::function<void()> frame_ready_;
+    std::thread render_thread_;
 };
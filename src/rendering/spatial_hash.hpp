@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+// Well-mixed 32-bit hash of integer grid coordinates. Procedural layers use
+// it to place features without storing them: the same cell always hashes to
+// the same value.
+inline uint32_t spatialHash(int x, int y, uint32_t seed) {
+    uint32_t h = seed;
+    h ^= static_cast<uint32_t>(x) * 0x9E3779B1u;
+    h ^= static_cast<uint32_t>(y) * 0x85EBCA77u;
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    h *= 0x846CA68Bu;
+    h ^= h >> 16;
+    return h;
+}
@@ -1,47 +1,126 @@
 #include "rendering/terrain_renderer.hpp"
 
-void TerrainRenderer::draw(ftxui::Canvas& canvas,
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+const char* TerrainRenderer::fillName(TerrainFill fill) {
+    switch (fill) {
+        case TerrainFill::Outline:  return "Outline";
+        case TerrainFill::Solid:    return "Solid";
+        case TerrainFill::Dithered: return "Dithered";
+    }
+    return "";
+}
+
+TerrainFill TerrainRenderer::nextFill(TerrainFill fill) {
+    switch (fill) {
+        case TerrainFill::Outline:  return TerrainFill::Solid;
+        case TerrainFill::Solid:    return TerrainFill::Dithered;
+        case TerrainFill::Dithered: break;
+    }
+    return TerrainFill::Outline;
+}
+
+int TerrainRenderer::lodLevel(float column_meters) {
+    // Level k spaces vertices SAMPLE_SPACING * 2^k apart
+    int lod = 0;
+    float spacing = LevelSegment::SAMPLE_SPACING * 2.0f;
+    while (lod < LevelSegment::MAX_LOD_LEVELS && spacing <= column_meters) {
+        ++lod;
+        spacing *= 2.0f;
+    }
+    return lod;
+}
+
+void TerrainRenderer::draw(DrawList& list,
                            const Camera& camera,
-                           const std::vector<LevelSegment>& segments) {
-    for (const auto& segment : segments) {
-        // Only draw segments visible in viewport
-        if (segment.end_x < camera.viewportLeft() ||
-            segment.start_x > camera.viewportRight()) {
-            continue;
+                           const std::vector<LevelSegment>& segments,
+                           int cell_width,
+                           TerrainFill fill) {
+    const int lod = lodLevel(cell_width / camera.pixelsPerMeter());
+
+    // Segments run left to right; draw only those in the viewport
+    auto first = std::partition_point(segments.begin(), segments.end(),
+        [&](const LevelSegment& s) { return s.end_x < camera.viewportLeft(); });
+    for (auto segment = first; segment != segments.end(); ++segment) {
+        if (segment->start_x > camera.viewportRight()) {
+            break;
         }
 
-        if (segment.is_goal) {
-            drawGoal(canvas, camera, segment);
+        const auto& points = segment->pointsAtLevel(lod);
+        if (fill == TerrainFill::Outline) {
+            drawPolyline(list, camera, points.data(), points.size());
         } else {
-            drawSegment(canvas, camera, segment);
+            drawFilled(list, camera, points.data(), points.size(), fill);
+        }
+        if (segment->is_goal) {
+            drawGoalPosts(list, camera, segment->end_x);
         }
     }
 }
 
-void TerrainRenderer::drawSegment(ftxui::Canvas& canvas,
-                                  const Camera& camera,
-                                  const LevelSegment& segment) {
+void TerrainRenderer::drawPolyline(DrawList& list,
+                                   const Camera& camera,
+                                   const b2Vec2* points,
+                                   size_t count) {
     // Draw the terrain curve with thicker lines
-    for (size_t i = 0; i + 1 < segment.sampled_points.size(); ++i) {
-        auto screen_a = camera.worldToScreen(segment.sampled_points[i]);
-        auto screen_b = camera.worldToScreen(segment.sampled_points[i + 1]);
+    for (size_t i = 0; i + 1 < count; ++i) {
+        auto screen_a = camera.worldToScreen(points[i]);
+        auto screen_b = camera.worldToScreen(points[i + 1]);
 
         // Draw the line
-        canvas.DrawPointLine(screen_a.x, screen_a.y, screen_b.x, screen_b.y);
+        list.line(screen_a.x, screen_a.y, screen_b.x, screen_b.y);
         // Draw slightly below for thickness
-        canvas.DrawPointLine(screen_a.x, screen_a.y + 1, screen_b.x, screen_b.y + 1);
+        list.line(screen_a.x, screen_a.y + 1, screen_b.x, screen_b.y + 1);
     }
-
 }
 
-void TerrainRenderer::drawGoal(ftxui::Canvas& canvas,
-                               const Camera& camera,
-                               const LevelSegment& segment) {
-    // Draw terrain
-    drawSegment(canvas, camera, segment);
+void TerrainRenderer::drawFilled(DrawList& list,
+                                 const Camera& camera,
+                                 const b2Vec2* points,
+                                 size_t count,
+                                 TerrainFill fill) {
+    if (count < 2) {
+        return;
+    }
+
+    // Columns covered by the run, clipped to the screen
+    auto ends_a = camera.worldToScreen(points[0]);
+    auto ends_b = camera.worldToScreen(points[count - 1]);
+    int x0 = std::max(0, std::min(ends_a.x, ends_b.x));
+    int x1 = std::min(camera.screenWidth() - 1, std::max(ends_a.x, ends_b.x));
+    if (x0 > x1) {
+        return;
+    }
+
+    // Highest surface row in each column
+    surface_.assign(x1 - x0 + 1, std::numeric_limits<int>::max());
+    for (size_t i = 0; i + 1 < count; ++i) {
+        auto a = camera.worldToScreen(points[i]);
+        auto b = camera.worldToScreen(points[i + 1]);
+        if (a.x > b.x) {
+            std::swap(a, b);
+        }
+        int lo = std::max(a.x, x0);
+        int hi = std::min(b.x, x1);
+        for (int x = lo; x <= hi; ++x) {
+            int y = a.x == b.x ? std::min(a.y, b.y)
+                               : a.y + (b.y - a.y) * (x - a.x) / (b.x - a.x);
+            surface_[x - x0] = std::min(surface_[x - x0], y);
+        }
+    }
+
+    bool dither = fill == TerrainFill::Dithered;
+    list.surfaceFill(surface_.data(), x0, static_cast<int>(surface_.size()), dither);
+    if (dither) {
+        // Keep a solid edge on top of the checkerboard
+        drawPolyline(list, camera, points, count);
+    }
+}
 
+void TerrainRenderer::drawGoalPosts(DrawList& list, const Camera& camera, float goal_x) {
     // Draw goal posts (two vertical lines)
-    float goal_x = segment.end_x;
     float goal_height = 5.0f;
 
     auto bottom_left = camera.worldToScreen({goal_x - 0.5f, 0.0f});
@@ -49,7 +128,7 @@ void TerrainRenderer::drawGoal(ftxui::Canvas& canvas,
     auto bottom_right = camera.worldToScreen({goal_x + 0.5f, 0.0f});
     auto top_right = camera.worldToScreen({goal_x + 0.5f, goal_height});
 
-    canvas.DrawPointLine(bottom_left.x, bottom_left.y, top_left.x, top_left.y);
-    canvas.DrawPointLine(bottom_right.x, bottom_right.y, top_right.x, top_right.y);
-    canvas.DrawPointLine(top_left.x, top_left.y, top_right.x, top_right.y);
+    list.line(bottom_left.x, bottom_left.y, top_left.x, top_left.y);
+    list.line(bottom_right.x, bottom_right.y, top_right.x, top_right.y);
+    list.line(top_left.x, top_left.y, top_right.x, top_right.y);
 }
@@ -1,27 +1,57 @@
 #pragma once
 
 #include "rendering/camera.hpp"
+#include "rendering/draw_list.hpp"
 #include "level/level_segment.hpp"
 
-#include <ftxui/dom/canvas.hpp>
+#include <box2d/box2d.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
+// How the ground below the terrain surface is drawn
+enum class TerrainFill : uint8_t {
+    Outline,  // Doubled surface line only
+    Solid,    // Everything below the surface set
+    Dithered, // Checkerboard below a surface line
+};
+
 class TerrainRenderer {
 public:
     TerrainRenderer() = default;
 
-    // Draw terrain segments
-    void draw(ftxui::Canvas& canvas,
+    static const char* fillName(TerrainFill fill);
+    static TerrainFill nextFill(TerrainFill fill);
+
+    // Coarsest LOD level that still has a vertex every column_meters
+    static int lodLevel(float column_meters);
+
+    // Draw the visible terrain segments at the LOD for cell_width pixel
+    // wide columns
+    void draw(DrawList& list,
               const Camera& camera,
-              const std::vector<LevelSegment>& segments);
+              const std::vector<LevelSegment>& segments,
+              int cell_width,
+              TerrainFill fill = TerrainFill::Outline);
 
-private:
-    void drawSegment(ftxui::Canvas& canvas,
-                     const Camera& camera,
-                     const LevelSegment& segment);
+    // Draw one terrain polyline with a doubled (thick) outline
+    void drawPolyline(DrawList& list,
+                      const Camera& camera,
+                      const b2Vec2* points,
+                      size_t count);
+
+    // Fill below one terrain polyline, one surface row per screen column of
+    // the part inside the viewport
+    void drawFilled(DrawList& list,
+                    const Camera& camera,
+                    const b2Vec2* points,
+                    size_t count,
+                    TerrainFill fill);
 
-    void drawGoal(ftxui::Canvas& canvas,
-                  const Camera& camera,
-                  const LevelSegment& segment);
+    // Draw goal posts standing at goal_x
+    void drawGoalPosts(DrawList& list, const Camera& camera, float goal_x);
+
+private:
+    std::vector<int> surface_; // Per-column surface rows for drawFilled
 };
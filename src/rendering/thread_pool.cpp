@@ -0,0 +1,76 @@
+#include "rendering/thread_pool.hpp"
+
+ThreadPool::ThreadPool(int thread_count) {
+    for (int i = 1; i < thread_count; ++i) {
+        workers_.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::run(int count, TaskFn fn, void* ctx) {
+    if (count <= 0) {
+        return;
+    }
+
+    // Nothing to share - skip the handshake
+    if (workers_.empty() || count == 1) {
+        for (int i = 0; i < count; ++i) {
+            fn(ctx, i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = fn;
+        task_ctx_ = ctx;
+        task_count_ = count;
+        next_index_.store(0);
+        pending_workers_ = static_cast<int>(workers_.size());
+        generation_++;
+    }
+    work_cv_.notify_all();
+
+    drain();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this] { return pending_workers_ == 0; });
+}
+
+void ThreadPool::drain() {
+    int i;
+    while ((i = next_index_.fetch_add(1)) < task_count_) {
+        task_(task_ctx_, i);
+    }
+}
+
+void ThreadPool::workerLoop() {
+    uint64_t seen_generation = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        work_cv_.wait(lock, [&] { return stopping_ || generation_ != seen_generation; });
+        if (stopping_) {
+            return;
+        }
+        seen_generation = generation_;
+
+        lock.unlock();
+        drain();
+        lock.lock();
+
+        if (--pending_workers_ == 0) {
+            done_cv_.notify_one();
+        }
+    }
+}
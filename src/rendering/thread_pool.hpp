@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for fork/join loops. The calling thread
+// takes part in every loop, so a pool of N threads starts N - 1 workers.
+class ThreadPool {
+public:
+    explicit ThreadPool(int thread_count);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int threadCount() const { return static_cast<int>(workers_.size()) + 1; }
+
+    // Call fn(i) for every i in [0, count) and wait for all of them.
+    // fn is borrowed for the duration of the call; nothing is allocated.
+    template <typename Fn>
+    void parallelFor(int count, Fn& fn) {
+        run(count, [](void* ctx, int i) { (*static_cast<Fn*>(ctx))(i); }, &fn);
+    }
+
+private:
+    using TaskFn = void (*)(void*, int);
+
+    void run(int count, TaskFn fn, void* ctx);
+    void drain();
+    void workerLoop();
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+
+    TaskFn task_ = nullptr;
+    void* task_ctx_ = nullptr;
+    int task_count_ = 0;
+    std::atomic<int> next_index_{0};
+    int pending_workers_ = 0;
+    uint64_t generation_ = 0;
+    bool stopping_ = false;
+};
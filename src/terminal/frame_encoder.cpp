@@ -0,0 +1,383 @@
+#include "terminal/frame_encoder.hpp"
+
+#include <ftxui/screen/string.hpp>
+
+#include <charconv>
+#include <cstdlib>
+
+namespace {
+
+int digits(int value) {
+    int count = 1;
+    while (value >= 10) {
+        value /= 10;
+        ++count;
+    }
+    return count;
+}
+
+void appendInt(std::string& out, int value) {
+    char buf[12];
+    auto result = std::to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, result.ptr);
+}
+
+void appendParam(std::string& params, const char* code) {
+    if (!params.empty()) {
+        params += ';';
+    }
+    params += code;
+}
+
+// Index of an exact match in the xterm 256-color cube or gray ramp, or -1
+int exactPaletteIndex(int r, int g, int b) {
+    constexpr int levels[6] = {0, 95, 135, 175, 215, 255};
+    auto level = [&](int value) {
+        for (int i = 0; i < 6; ++i) {
+            if (levels[i] == value) {
+                return i;
+            }
+        }
+        return -1;
+    };
+
+    int ri = level(r), gi = level(g), bi = level(b);
+    if (ri >= 0 && gi >= 0 && bi >= 0) {
+        return 16 + 36 * ri + 6 * gi + bi;
+    }
+    if (r == g && g == b && r >= 8 && r <= 238 && (r - 8) % 10 == 0) {
+        return 232 + (r - 8) / 10;
+    }
+    return -1;
+}
+
+// Shortest SGR parameters that select the same color as FTXUI's encoding
+// ("38;5;n", "38;2;r;g;b" or a 16-color code)
+std::string shortestColorCode(const std::string& printed, bool background,
+                              ftxui::Terminal::Color support) {
+    const int base = background ? 40 : 30;
+    if (printed.size() < 5 || printed.compare(1, 4, "8;5;") != 0) {
+        if (printed.size() < 5 || printed.compare(1, 4, "8;2;") != 0 ||
+            support < ftxui::Terminal::Color::Palette256) {
+            return printed;
+        }
+
+        // Truecolor that sits exactly on the 256-color palette
+        const char* p = printed.c_str() + 5;
+        char* end = nullptr;
+        int r = static_cast<int>(std::strtol(p, &end, 10));
+        int g = static_cast<int>(std::strtol(end + 1, &end, 10));
+        int b = static_cast<int>(std::strtol(end + 1, &end, 10));
+        int index = exactPaletteIndex(r, g, b);
+        if (index < 0) {
+            return printed;
+        }
+        std::string code = background ? "48;5;" : "38;5;";
+        appendInt(code, index);
+        return code.size() < printed.size() ? code : printed;
+    }
+
+    // The first 16 palette entries are the 16 basic colors
+    int index = std::atoi(printed.c_str() + 5);
+    if (index < 8) {
+        return std::to_string(base + index);
+    }
+    if (index < 16) {
+        return std::to_string(base + 60 + index - 8);
+    }
+    return printed;
+}
+
+} // namespace
+
+FrameEncoder::FrameEncoder(ftxui::Terminal::Color color_support)
+    : color_support_(color_support) {}
+
+void FrameEncoder::encode(const ftxui::Screen& screen, std::string& out) {
+    int width = screen.dimx();
+    int height = screen.dimy();
+
+    if (!valid_ || width != width_ || height != height_) {
+        // Start from a blank screen; the diff below then only writes
+        // non-blank cells
+        out += "\x1b[?25l\x1b[0m\x1b[2J";
+        previous_.assign(static_cast<size_t>(width) * height, ftxui::Pixel());
+        width_ = width;
+        height_ = height;
+        valid_ = true;
+        cursor_x_ = cursor_y_ = -1;
+        pen_ = ftxui::Pixel();
+    }
+
+    for (int y = 0; y < height; ++y) {
+        const ftxui::Pixel* prev_row = &previous_[static_cast<size_t>(y) * width];
+        int x = 0;
+        while (x < width) {
+            if (sameCell(prev_row[x], screen.PixelAt(x, y))) {
+                ++x;
+                continue;
+            }
+
+            // Grow the run over short unchanged gaps
+            int begin = x;
+            int end = x + 1;
+            int gap = 0;
+            for (int j = x + 1; j < width; ++j) {
+                if (!sameCell(prev_row[j], screen.PixelAt(j, y))) {
+                    end = j + 1;
+                    gap = 0;
+                } else if (++gap > MAX_MERGE_GAP) {
+                    break;
+                }
+            }
+
+            // Keep wide glyphs together with their continuation cells, in
+            // this frame and in what the terminal shows
+            while (begin > 0 &&
+                   (isWide(screen.PixelAt(begin - 1, y)) || isWide(prev_row[begin - 1]))) {
+                --begin;
+            }
+            while (end < width &&
+                   (isWide(screen.PixelAt(end - 1, y)) || isWide(prev_row[end - 1]))) {
+                ++end;
+            }
+
+            encodeRun(screen, out, y, begin, end);
+            x = end;
+        }
+    }
+}
+
+void FrameEncoder::resetPen(std::string& out) {
+    if (!sameStyle(pen_, ftxui::Pixel())) {
+        out += "\x1b[0m";
+        pen_ = ftxui::Pixel();
+    }
+}
+
+void FrameEncoder::encodeRun(const ftxui::Screen& screen, std::string& out,
+                             int y, int x_begin, int x_end) {
+    moveCursor(out, x_begin, y);
+
+    ftxui::Pixel* prev_row = &previous_[static_cast<size_t>(y) * width_];
+    bool continuation = x_begin > 0 && isWide(screen.PixelAt(x_begin - 1, y));
+    for (int x = x_begin; x < x_end; ++x) {
+        const ftxui::Pixel& pixel = screen.PixelAt(x, y);
+        prev_row[x] = pixel;
+
+        // The cell after a wide glyph is its right half, whatever it holds
+        // (as in FTXUI's Screen::ToString): already drawn, cursor past it
+        if (!continuation) {
+            // Blanks ride along in whatever pen is current when it can't show
+            if (!isBlank(pixel) || !penHidesInBlank()) {
+                applyStyle(out, pixel);
+            }
+            // Cells nothing drew into are empty and show as a space
+            if (pixel.character.empty()) {
+                out += ' ';
+            } else {
+                out += pixel.character;
+            }
+        }
+        continuation = isWide(pixel);
+        ++cursor_x_;
+    }
+}
+
+void FrameEncoder::moveCursor(std::string& out, int x, int y) {
+    if (cursor_x_ == x && cursor_y_ == y) {
+        return;
+    }
+
+    // Absolute position is always valid
+    int best_cost = 4 + digits(y + 1) + digits(x + 1);
+    enum class Move { Absolute, Forward, Return, NextLine } best = Move::Absolute;
+
+    bool known = cursor_x_ >= 0 && cursor_y_ >= 0;
+    // After the last column the terminal is in a pending-wrap state where
+    // relative forward moves are unreliable
+    bool in_row = known && cursor_x_ < width_;
+
+    if (in_row && cursor_y_ == y && x > cursor_x_) {
+        int n = x - cursor_x_;
+        int cost = 3 + (n > 1 ? digits(n) : 0);
+        if (cost < best_cost) {
+            best_cost = cost;
+            best = Move::Forward;
+        }
+    }
+    if (known && cursor_y_ == y && x == 0 && 1 < best_cost) {
+        best_cost = 1;
+        best = Move::Return;
+    }
+    if (known && y == cursor_y_ + 1 && x == 0 && 2 < best_cost) {
+        best_cost = 2;
+        best = Move::NextLine;
+    }
+
+    switch (best) {
+        case Move::Absolute:
+            out += "\x1b[";
+            appendInt(out, y + 1);
+            out += ';';
+            appendInt(out, x + 1);
+            out += 'H';
+            break;
+        case Move::Forward: {
+            int n = x - cursor_x_;
+            out += "\x1b[";
+            if (n > 1) {
+                appendInt(out, n);
+            }
+            out += 'C';
+            break;
+        }
+        case Move::Return:
+            out += '\r';
+            break;
+        case Move::NextLine:
+            out += "\r\n";
+            break;
+    }
+
+    cursor_x_ = x;
+    cursor_y_ = y;
+}
+
+void FrameEncoder::applyStyle(std::string& out, const ftxui::Pixel& pixel) {
+    if (sameStyle(pen_, pixel)) {
+        return;
+    }
+
+    // Either reset and set everything...
+    full_params_.assign("0");
+    if (pixel.bold) appendParam(full_params_, "1");
+    if (pixel.dim) appendParam(full_params_, "2");
+    if (pixel.italic) appendParam(full_params_, "3");
+    if (pixel.underlined) appendParam(full_params_, "4");
+    if (pixel.blink) appendParam(full_params_, "5");
+    if (pixel.inverted) appendParam(full_params_, "7");
+    if (pixel.strikethrough) appendParam(full_params_, "9");
+    if (pixel.underlined_double) appendParam(full_params_, "21");
+    if (pixel.foreground_color != ftxui::Color::Default) {
+        appendColor(full_params_, pixel.foreground_color, false);
+    }
+    if (pixel.background_color != ftxui::Color::Default) {
+        appendColor(full_params_, pixel.background_color, true);
+    }
+
+    // ...or change only what differs from the pen
+    const ftxui::Pixel& pen = pen_;
+    delta_params_.clear();
+    if ((pen.bold && !pixel.bold) || (pen.dim && !pixel.dim)) {
+        // 22 clears both bold and dim
+        appendParam(delta_params_, "22");
+        if (pixel.bold) appendParam(delta_params_, "1");
+        if (pixel.dim) appendParam(delta_params_, "2");
+    } else {
+        if (pixel.bold && !pen.bold) appendParam(delta_params_, "1");
+        if (pixel.dim && !pen.dim) appendParam(delta_params_, "2");
+    }
+    if ((pen.underlined && !pixel.underlined) ||
+        (pen.underlined_double && !pixel.underlined_double)) {
+        // 24 clears both underline styles
+        appendParam(delta_params_, "24");
+        if (pixel.underlined) appendParam(delta_params_, "4");
+        if (pixel.underlined_double) appendParam(delta_params_, "21");
+    } else {
+        if (pixel.underlined && !pen.underlined) appendParam(delta_params_, "4");
+        if (pixel.underlined_double && !pen.underlined_double) appendParam(delta_params_, "21");
+    }
+    if (pixel.italic != pen.italic) appendParam(delta_params_, pixel.italic ? "3" : "23");
+    if (pixel.blink != pen.blink) appendParam(delta_params_, pixel.blink ? "5" : "25");
+    if (pixel.inverted != pen.inverted) appendParam(delta_params_, pixel.inverted ? "7" : "27");
+    if (pixel.strikethrough != pen.strikethrough) {
+        appendParam(delta_params_, pixel.strikethrough ? "9" : "29");
+    }
+    if (pixel.foreground_color != pen.foreground_color) {
+        appendColor(delta_params_, pixel.foreground_color, false);
+    }
+    if (pixel.background_color != pen.background_color) {
+        appendColor(delta_params_, pixel.background_color, true);
+    }
+
+    pen_ = pixel;
+    if (delta_params_.empty()) {
+        return; // Only colors the terminal can't show changed
+    }
+
+    out += "\x1b[";
+    out += delta_params_.size() < full_params_.size() ? delta_params_ : full_params_;
+    out += 'm';
+}
+
+void FrameEncoder::appendColor(std::string& params, const ftxui::Color& color, bool background) {
+    if (color_support_ == ftxui::Terminal::Color::Palette1) {
+        return;
+    }
+    if (color == ftxui::Color::Default) {
+        appendParam(params, background ? "49" : "39");
+        return;
+    }
+
+    for (const auto& code : color_codes_) {
+        if (code.color == color) {
+            appendParam(params, (background ? code.background : code.foreground).c_str());
+            return;
+        }
+    }
+
+    ColorCode code;
+    code.color = color;
+    code.foreground = shortestColorCode(color.Print(false), false, color_support_);
+    code.background = shortestColorCode(color.Print(true), true, color_support_);
+    color_codes_.push_back(std::move(code));
+
+    const ColorCode& added = color_codes_.back();
+    appendParam(params, (background ? added.background : added.foreground).c_str());
+}
+
+bool FrameEncoder::penHidesInBlank() const {
+    return pen_.background_color == ftxui::Color::Default &&
+           !pen_.inverted &&
+           !pen_.underlined &&
+           !pen_.underlined_double &&
+           !pen_.strikethrough;
+}
+
+bool FrameEncoder::isWide(const ftxui::Pixel& pixel) {
+    // Single-byte characters are never wide; skip the width lookup
+    return pixel.character.size() > 1 && ftxui::string_width(pixel.character) == 2;
+}
+
+bool FrameEncoder::isBlank(const ftxui::Pixel& pixel) {
+    return (pixel.character.empty() || pixel.character == " ") &&
+           pixel.background_color == ftxui::Color::Default &&
+           !pixel.inverted &&
+           !pixel.underlined &&
+           !pixel.underlined_double &&
+           !pixel.strikethrough;
+}
+
+bool FrameEncoder::sameStyle(const ftxui::Pixel& a, const ftxui::Pixel& b) {
+    return a.bold == b.bold &&
+           a.dim == b.dim &&
+           a.italic == b.italic &&
+           a.underlined == b.underlined &&
+           a.underlined_double == b.underlined_double &&
+           a.blink == b.blink &&
+           a.inverted == b.inverted &&
+           a.strikethrough == b.strikethrough &&
+           a.foreground_color == b.foreground_color &&
+           a.background_color == b.background_color;
+}
+
+bool FrameEncoder::sameCell(const ftxui::Pixel& a, const ftxui::Pixel& b) {
+    if (isBlank(a) && isBlank(b)) {
+        return true; // Foreground style doesn't show on a blank
+    }
+    const bool same_character = a.character == b.character ||
+                                ((a.character.empty() || a.character == " ") &&
+                                 (b.character.empty() || b.character == " "));
+    return same_character && sameStyle(a, b);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <ftxui/screen/screen.hpp>
+#include <ftxui/screen/terminal.hpp>
+
+#include <string>
+#include <vector>
+
+// Turns successive screens into the escape sequences that update the
+// terminal from one to the next. Only runs of changed cells are written;
+// cursor moves and style changes each use their shortest encoding, and the
+// pen carries over from one frame to the next.
+class FrameEncoder {
+public:
+    explicit FrameEncoder(ftxui::Terminal::Color color_support = ftxui::Terminal::ColorSupport());
+
+    // Append the bytes that turn the previous screen into this one
+    void encode(const ftxui::Screen& screen, std::string& out);
+
+    // Append a pen reset if the pen isn't plain, so bytes written after the
+    // frame don't inherit its style
+    void resetPen(std::string& out);
+
+    // Forget what is on the terminal; the next frame repaints every cell
+    void invalidate() { valid_ = false; }
+
+private:
+    void encodeRun(const ftxui::Screen& screen, std::string& out, int y, int x_begin, int x_end);
+    void moveCursor(std::string& out, int x, int y);
+    void applyStyle(std::string& out, const ftxui::Pixel& pixel);
+    void appendColor(std::string& params, const ftxui::Color& color, bool background);
+
+    // The pen's color and intensity don't show on a blank cell
+    bool penHidesInBlank() const;
+    // Takes two columns; the next cell is its continuation
+    static bool isWide(const ftxui::Pixel& pixel);
+    // Empty (never drawn) and space cells both show as a space
+    static bool isBlank(const ftxui::Pixel& pixel);
+    static bool sameCell(const ftxui::Pixel& a, const ftxui::Pixel& b);
+    static bool sameStyle(const ftxui::Pixel& a, const ftxui::Pixel& b);
+
+    // Unchanged cells shorter than this between two changed runs are
+    // rewritten rather than skipped with a cursor move
+    static constexpr int MAX_MERGE_GAP = 4;
+
+    ftxui::Terminal::Color color_support_;
+
+    // Shortest SGR parameters per color, so Color::Print runs once per color
+    struct ColorCode {
+        ftxui::Color color;
+        std::string foreground;
+        std::string background;
+    };
+    std::vector<ColorCode> color_codes_;
+    std::string full_params_;
+    std::string delta_params_;
+
+    // What the terminal currently shows
+    std::vector<ftxui::Pixel> previous_;
+    int width_ = 0;
+    int height_ = 0;
+    bool valid_ = false;
+
+    // Terminal cursor and pen while encoding (-1 = unknown)
+    int cursor_x_ = -1;
+    int cursor_y_ = -1;
+    ftxui::Pixel pen_;
+};
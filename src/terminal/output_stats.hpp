@@ -0,0 +1,21 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// Terminal output accounting, updated once per presented frame
+struct OutputStats {
+    uint64_t frames = 0;
+    uint64_t frames_dropped = 0; // Skipped while the previous frame drained
+    uint64_t total_bytes = 0;    // Frame bytes queued for the terminal so far
+    size_t frame_bytes = 0;      // Bytes written for the last frame
+    size_t full_frame_bytes = 0; // Bytes a full repaint of that frame would take
+    double avg_frame_bytes = 0.0;
+    double avg_full_frame_bytes = 0.0;
+    // Diffing, encoding and the first write attempt of the last frame
+    std::chrono::steady_clock::duration write_time{};
+    // Newest tagged frame fully written to the terminal, and when
+    uint64_t written_tag = 0;
+    std::chrono::steady_clock::time_point written_at{};
+};
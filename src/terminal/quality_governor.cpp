@@ -0,0 +1,133 @@
+#include "terminal/quality_governor.hpp"
+
+#include <algorithm>
+
+namespace {
+
+double millisecondsSince(QualityGovernor::Clock::time_point then,
+                         QualityGovernor::Clock::time_point now) {
+    return std::chrono::duration<double, std::milli>(now - then).count();
+}
+
+} // namespace
+
+void QualityGovernor::update(const OutputStats& stats, Clock::time_point now) {
+    if (window_start_ == Clock::time_point{}) {
+        window_start_ = last_change_ = clear_since_ = now;
+        window_frames_ = stats.frames;
+        window_dropped_ = stats.frames_dropped;
+        window_bytes_ = stats.total_bytes;
+        return;
+    }
+
+    // An unanswered probe has taken at least as long as it has been out
+    double round_trip = round_trip_ms_;
+    if (probe_outstanding_) {
+        if (probe_supported_) {
+            round_trip = std::max(round_trip, millisecondsSince(probe_sent_, now));
+        } else if (now - probe_sent_ > PROBE_GIVE_UP) {
+            probe_outstanding_ = false;
+            probe_disabled_ = true;
+        }
+    }
+
+    if (now - window_start_ < WINDOW) {
+        return;
+    }
+
+    double seconds = std::chrono::duration<double>(now - window_start_).count();
+    uint64_t frames = stats.frames - window_frames_;
+    uint64_t dropped = stats.frames_dropped - window_dropped_;
+    throughput_ = static_cast<double>(stats.total_bytes - window_bytes_) / seconds;
+
+    window_start_ = now;
+    window_frames_ = stats.frames;
+    window_dropped_ = stats.frames_dropped;
+    window_bytes_ = stats.total_bytes;
+
+    double drop_ratio = frames + dropped > 0
+        ? static_cast<double>(dropped) / static_cast<double>(frames + dropped)
+        : 0.0;
+    bool congested = drop_ratio > DROP_RATIO_HIGH || round_trip > RTT_HIGH_MS;
+    bool clear = dropped == 0 && round_trip < RTT_LOW_MS;
+
+    if (congested) {
+        clear_since_ = now;
+        if (now - last_change_ >= STEP_DOWN_HOLD) {
+            stepDown(now);
+        }
+    } else if (!clear) {
+        clear_since_ = now;
+    } else if (now - clear_since_ >= STEP_UP_HOLD) {
+        // The rate that congested the link is only a hint: links recover
+        bool under_ceiling = saturated_throughput_ <= 0.0 ||
+                             throughput_ < saturated_throughput_ * UP_HEADROOM ||
+                             now - last_change_ >= CEILING_EXPIRY;
+        if (under_ceiling) {
+            stepUp(now);
+        }
+    }
+}
+
+bool QualityGovernor::takeProbe(Clock::time_point now) {
+    if (probe_disabled_ || probe_outstanding_) {
+        return false;
+    }
+    if (probe_sent_ != Clock::time_point{} && now - probe_sent_ < PROBE_INTERVAL) {
+        return false;
+    }
+    probe_outstanding_ = true;
+    probe_sent_ = now;
+    return true;
+}
+
+bool QualityGovernor::handleInput(const std::string& input, Clock::time_point now) {
+    // DA1 reply: CSI ? Ps ; ... c
+    if (input.size() < 4 || input.compare(0, 3, "\x1b[?") != 0 || input.back() != 'c') {
+        return false;
+    }
+    if (!probe_outstanding_) {
+        return true; // Late reply to a probe already given up on
+    }
+
+    double sample = millisecondsSince(probe_sent_, now);
+    round_trip_ms_ = probe_supported_
+        ? round_trip_ms_ + RTT_SMOOTHING * (sample - round_trip_ms_)
+        : sample;
+    probe_supported_ = true;
+    probe_outstanding_ = false;
+    return true;
+}
+
+QualityGovernor::Clock::duration QualityGovernor::frameInterval() const {
+    int fps = level_ >= QualityLevel::ReducedFps ? 30 : 60;
+    return std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)) / fps;
+}
+
+const char* QualityGovernor::levelName(QualityLevel level) {
+    switch (level) {
+        case QualityLevel::Full:           return "full";
+        case QualityLevel::ReducedFps:     return "30fps";
+        case QualityLevel::NoTextBar:      return "no text bar";
+        case QualityLevel::NoMaskColor:    return "no mask color";
+        case QualityLevel::HalfResTerrain: return "half-res terrain";
+    }
+    return "";
+}
+
+void QualityGovernor::stepDown(Clock::time_point now) {
+    if (level_ == QualityLevel::HalfResTerrain) {
+        return;
+    }
+    saturated_throughput_ = throughput_;
+    level_ = static_cast<QualityLevel>(static_cast<uint8_t>(level_) + 1);
+    last_change_ = now;
+}
+
+void QualityGovernor::stepUp(Clock::time_point now) {
+    if (level_ == QualityLevel::Full) {
+        return;
+    }
+    level_ = static_cast<QualityLevel>(static_cast<uint8_t>(level_) - 1);
+    last_change_ = clear_since_ = now;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "terminal/output_stats.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Each level keeps the savings of the ones before it
+enum class QualityLevel : uint8_t {
+    Full,
+    ReducedFps,     // 30 FPS instead of 60
+    NoTextBar,      // Skip the text bar overlay
+    NoMaskColor,    // Draw the mask without color escapes
+    HalfResTerrain, // Every other terrain sample
+};
+
+// Adapts render quality to what the terminal link can carry. Terminal
+// backlog shows up two ways: frames dropped by the presenter because the
+// previous one hasn't drained, and the round-trip time of a device
+// attributes query, which the terminal only answers once it has processed
+// everything sent before it. Congestion steps quality down one level at a
+// time; a sustained clean period with throughput well below the rate that
+// congested the link steps it back up.
+class QualityGovernor {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Primary device attributes request. Used instead of DSR because FTXUI
+    // consumes cursor position reports internally.
+    static constexpr char PROBE[] = "\x1b[c";
+
+    // Once per loop iteration, after the frame was presented
+    void update(const OutputStats& stats, Clock::time_point now);
+
+    // True when a probe should be written now; marks it as sent
+    bool takeProbe(Clock::time_point now);
+
+    // Returns true if the input was a probe reply (and should be consumed)
+    bool handleInput(const std::string& input, Clock::time_point now);
+
+    QualityLevel level() const { return level_; }
+    Clock::duration frameInterval() const;
+    bool showTextBar() const { return level_ < QualityLevel::NoTextBar; }
+    bool maskColor() const { return level_ < QualityLevel::NoMaskColor; }
+    bool halfResTerrain() const { return level_ >= QualityLevel::HalfResTerrain; }
+
+    double throughput() const { return throughput_; } // Bytes per second
+    double roundTripMs() const { return round_trip_ms_; }
+
+    static const char* levelName(QualityLevel level);
+
+private:
+    void stepDown(Clock::time_point now);
+    void stepUp(Clock::time_point now);
+
+    static constexpr auto WINDOW = std::chrono::milliseconds(500);
+    static constexpr auto PROBE_INTERVAL = std::chrono::milliseconds(1000);
+    static constexpr auto PROBE_GIVE_UP = std::chrono::milliseconds(5000);
+    static constexpr auto STEP_DOWN_HOLD = std::chrono::milliseconds(1000);
+    static constexpr auto STEP_UP_HOLD = std::chrono::milliseconds(3000);
+    static constexpr auto CEILING_EXPIRY = std::chrono::seconds(30);
+    static constexpr double RTT_HIGH_MS = 200.0;
+    static constexpr double RTT_LOW_MS = 60.0;
+    static constexpr double DROP_RATIO_HIGH = 0.1;
+    static constexpr double UP_HEADROOM = 0.6; // Fraction of the congested rate
+    static constexpr double RTT_SMOOTHING = 0.3;
+
+    QualityLevel level_ = QualityLevel::Full;
+    Clock::time_point last_change_{};
+    Clock::time_point clear_since_{};
+    double saturated_throughput_ = 0.0; // Rate at the last step down
+
+    // Measurement window
+    Clock::time_point window_start_{};
+    uint64_t window_frames_ = 0;
+    uint64_t window_dropped_ = 0;
+    uint64_t window_bytes_ = 0;
+    double throughput_ = 0.0;
+
+    // Round-trip probe
+    bool probe_outstanding_ = false;
+    bool probe_supported_ = false; // Terminal answered at least once
+    bool probe_disabled_ = false;  // Never answered; rely on drops alone
+    Clock::time_point probe_sent_{};
+    double round_trip_ms_ = 0.0;
+};
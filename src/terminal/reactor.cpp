@@ -0,0 +1,188 @@
+#include "terminal/reactor.hpp"
+#include "debug_log.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <thread>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr int WAKE_SIGNALS[] = {SIGWINCH, SIGINT, SIGTERM};
+
+// epoll user data
+enum Source : uint64_t { SOURCE_INPUT, SOURCE_WAKE, SOURCE_TIMER };
+
+bool addFd(int epoll_fd, int fd, Source source) {
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u64 = source;
+    return epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0;
+}
+
+sigset_t wakeSignalSet() {
+    sigset_t mask;
+    sigemptyset(&mask);
+    for (int signum : WAKE_SIGNALS) {
+        sigaddset(&mask, signum);
+    }
+    return mask;
+}
+
+timespec toTimespec(Reactor::Clock::duration d) {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+    return {static_cast<time_t>(ns / 1000000000), static_cast<long>(ns % 1000000000)};
+}
+
+} // namespace
+
+Reactor::Reactor() {
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd_ < 0) {
+        fallBack("epoll_create1");
+        return;
+    }
+    timer_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timer_fd_ < 0) {
+        fallBack("timerfd_create");
+        return;
+    }
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ < 0) {
+        fallBack("eventfd");
+        return;
+    }
+    if (!addFd(epoll_fd_, timer_fd_, SOURCE_TIMER) || !addFd(epoll_fd_, wake_fd_, SOURCE_WAKE)) {
+        fallBack("epoll_ctl");
+        return;
+    }
+
+    pthread_sigmask(SIG_SETMASK, nullptr, &wait_mask_);
+    for (int signum : WAKE_SIGNALS) {
+        sigdelset(&wait_mask_, signum);
+    }
+}
+
+Reactor::~Reactor() {
+    for (int fd : {epoll_fd_, timer_fd_, wake_fd_}) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+void Reactor::blockSignals() {
+    const sigset_t mask = wakeSignalSet();
+    pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+}
+
+bool Reactor::watchInput(int fd) {
+    return polling_ && addFd(epoll_fd_, fd, SOURCE_INPUT);
+}
+
+void Reactor::armFrameTimer(Clock::duration interval) {
+    if (interval == interval_) {
+        return;
+    }
+    interval_ = interval;
+    if (!polling_) {
+        return;
+    }
+    itimerspec spec{};
+    spec.it_interval = toTimespec(interval);
+    spec.it_value = spec.it_interval;
+    timerfd_settime(timer_fd_, 0, &spec, nullptr);
+}
+
+void Reactor::disarmFrameTimer() {
+    if (interval_ == Clock::duration::zero()) {
+        return;
+    }
+    interval_ = Clock::duration::zero();
+    if (!polling_) {
+        return;
+    }
+    itimerspec spec{};
+    timerfd_settime(timer_fd_, 0, &spec, nullptr);
+
+    // Drop a tick that fired before the timer stopped
+    uint64_t expirations;
+    while (read(timer_fd_, &expirations, sizeof(expirations)) < 0 && errno == EINTR) {
+    }
+}
+
+void Reactor::wake() {
+    if (wake_fd_ < 0) {
+        return; // Falling back: the next tick shows the frame
+    }
+    uint64_t one = 1;
+    while (write(wake_fd_, &one, sizeof(one)) < 0 && errno == EINTR) {
+    }
+}
+
+uint32_t Reactor::wait() {
+    if (!polling_) {
+        return sleepUntilTick();
+    }
+
+    epoll_event events[3];
+    int count = epoll_pwait(epoll_fd_, events, 3, -1, &wait_mask_);
+    if (count < 0) {
+        if (errno == EINTR) {
+            return SIGNAL;
+        }
+        fallBack("epoll_pwait");
+        return sleepUntilTick();
+    }
+
+    uint32_t ready = 0;
+    for (int i = 0; i < count; ++i) {
+        uint64_t value;
+        switch (events[i].data.u64) {
+            case SOURCE_INPUT:
+                // Left for the reader; level-triggered, so unread input
+                // wakes the next wait again
+                ready |= INPUT;
+                break;
+            case SOURCE_WAKE:
+                // Several wake() calls collapse into one
+                while (read(wake_fd_, &value, sizeof(value)) < 0 && errno == EINTR) {
+                }
+                ready |= WAKE;
+                break;
+            case SOURCE_TIMER:
+                // Missed ticks collapse into one; frames are dropped, not queued
+                if (read(timer_fd_, &value, sizeof(value)) == sizeof(value)) {
+                    ready |= TIMER;
+                }
+                break;
+        }
+    }
+    return ready;
+}
+
+void Reactor::fallBack([[maybe_unused]] const char* call) {
+    [[maybe_unused]] const int error = errno;
+    LOG_ERROR("reactor.fallback", "call", call, "errno", error);
+    polling_ = false;
+    next_tick_ = Clock::now();
+
+    // Nothing unblocks the wake-up signals around a wait any more. Worker
+    // threads keep them blocked, so they still reach this thread.
+    const sigset_t mask = wakeSignalSet();
+    pthread_sigmask(SIG_UNBLOCK, &mask, nullptr);
+}
+
+uint32_t Reactor::sleepUntilTick() {
+    const Clock::duration interval =
+        interval_ != Clock::duration::zero() ? interval_ : Clock::duration(FALLBACK_INTERVAL);
+    // Late ticks are dropped, not caught up
+    next_tick_ = std::max(next_tick_ + interval, Clock::now());
+    std::this_thread::sleep_until(next_tick_);
+    // Without polling, input may have arrived on any tick
+    return TIMER | INPUT;
+}
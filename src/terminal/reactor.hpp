@@ -0,0 +1,71 @@
+#pragma once
+
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+
+// What the main loop sleeps on between iterations: terminal input, wake()
+// from another thread, a signal, and a frame timer. The timer is only
+// armed while frames are needed, so a session sitting in a menu blocks in
+// epoll_pwait and costs no CPU.
+//
+// The signals FTXUI handles (resize, interrupt, terminate) are blocked
+// everywhere except inside wait(), so they always interrupt it rather than
+// landing on a worker thread while the main thread sleeps.
+//
+// If epoll, the timer or the eventfd can't be set up (or epoll_pwait fails
+// later), the reactor logs why and falls back to the fixed-interval loop it
+// replaced: wait() sleeps until the next frame tick and reports a tick with
+// possible input, and the wake-up signals are unblocked again so FTXUI
+// still sees them.
+class Reactor {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Bits returned by wait()
+    static constexpr uint32_t INPUT = 1u << 0;  // Watched fd is readable
+    static constexpr uint32_t WAKE = 1u << 1;   // wake() was called
+    static constexpr uint32_t TIMER = 1u << 2;  // Frame timer ticked
+    static constexpr uint32_t SIGNAL = 1u << 3; // A blocked signal arrived
+
+    Reactor();
+    ~Reactor();
+
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+
+    // Block the wake-up signals in the calling thread and in every thread
+    // it starts afterwards. Call at startup, before any thread exists.
+    static void blockSignals();
+
+    // Wake when fd has input. Returns false if it can't be polled (a
+    // regular file, or no epoll); the caller then has to keep the timer
+    // running.
+    bool watchInput(int fd);
+
+    // Tick every `interval` from now on, or stop ticking. Only touches the
+    // timer when the setting changes, so it can be called every iteration.
+    void armFrameTimer(Clock::duration interval);
+    void disarmFrameTimer();
+
+    // Any thread
+    void wake();
+
+    // Block until at least one source is ready; returns its bits
+    uint32_t wait();
+
+private:
+    // Tick length while falling back with the timer disarmed
+    static constexpr auto FALLBACK_INTERVAL = std::chrono::milliseconds(16);
+
+    void fallBack(const char* call);
+    uint32_t sleepUntilTick();
+
+    bool polling_ = true;          // False once fallen back to sleeping
+    Clock::time_point next_tick_;  // While falling back
+    int epoll_fd_ = -1;
+    int timer_fd_ = -1;
+    int wake_fd_ = -1;
+    Clock::duration interval_{0}; // Zero while disarmed
+    sigset_t wait_mask_{};        // Signal mask while inside wait()
+};
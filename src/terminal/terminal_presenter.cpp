@@ -0,0 +1,203 @@
+#include "terminal/terminal_presenter.hpp"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <iostream>
+#include <poll.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr double STATS_SMOOTHING = 0.05; // EMA weight of the newest frame
+
+// DEC private mode 2026: the terminal holds the screen until the frame is
+// complete, so a frame split across several reads never shows half-drawn.
+// Terminals without support ignore it
+constexpr char SYNC_BEGIN[] = "\x1b[?2026h";
+constexpr char SYNC_END[] = "\x1b[?2026l";
+
+} // namespace
+
+TerminalPresenter::TerminalPresenter(ftxui::Screen& screen)
+    : screen_(screen) {
+    if (isatty(STDOUT_FILENO)) {
+        if (const char* path = ttyname(STDOUT_FILENO)) {
+            fd_ = ::open(path, O_WRONLY | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+            own_fd_ = fd_ >= 0;
+        }
+    }
+    if (fd_ < 0) {
+        // Redirected output (or no tty name): writes won't stall on a reader
+        fd_ = STDOUT_FILENO;
+    }
+
+    previous_buf_ = std::cout.rdbuf(this);
+}
+
+TerminalPresenter::~TerminalPresenter() {
+    in_frame_ = false;
+    sync();
+    out_.clear();
+    encoder_.resetPen(out_);
+    writeAll(out_);
+    std::cout.rdbuf(previous_buf_);
+    if (own_fd_) {
+        ::close(fd_);
+    }
+}
+
+void TerminalPresenter::beginFrame() {
+    // Anything still buffered belongs to the terminal setup - pass it on
+    sync();
+    flushPending();
+    in_frame_ = true;
+}
+
+void TerminalPresenter::endFrame() {
+    sync();
+    in_frame_ = false;
+}
+
+TerminalPresenter::int_type TerminalPresenter::overflow(int_type ch) {
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        captured_.push_back(traits_type::to_char_type(ch));
+    }
+    return traits_type::not_eof(ch);
+}
+
+std::streamsize TerminalPresenter::xsputn(const char* s, std::streamsize n) {
+    captured_.append(s, static_cast<size_t>(n));
+    return n;
+}
+
+int TerminalPresenter::sync() {
+    if (captured_.empty()) {
+        return 0;
+    }
+
+    if (in_frame_) {
+        // FTXUI flushes right after rendering into the screen, so the cell
+        // grid holds exactly the frame it just serialized
+        presentFrame();
+    } else {
+        // Don't let frame styling leak into setup/teardown output
+        out_.clear();
+        encoder_.resetPen(out_);
+        out_ += captured_;
+        writeAll(out_);
+        encoder_.invalidate();
+    }
+    captured_.clear();
+    return 0;
+}
+
+void TerminalPresenter::presentFrame() {
+    const auto start = std::chrono::steady_clock::now();
+    if (!flushPending()) {
+        // Terminal is still behind. The encoder only records what was queued,
+        // so this frame's changes go out with the next diff instead
+        stats_.frames_dropped++;
+        frame_tag_ = 0;
+        return;
+    }
+
+    out_.clear();
+    out_ += SYNC_BEGIN;
+    const size_t body_begin = out_.size();
+    encoder_.encode(screen_, out_);
+
+    if (out_.size() == body_begin) {
+        out_.clear();
+    } else {
+        out_ += SYNC_END;
+    }
+
+    stats_.frames++;
+    stats_.frame_bytes = out_.size();
+    stats_.total_bytes += out_.size();
+    stats_.full_frame_bytes = captured_.size();
+    if (stats_.frames == 1) {
+        stats_.avg_frame_bytes = static_cast<double>(stats_.frame_bytes);
+        stats_.avg_full_frame_bytes = static_cast<double>(stats_.full_frame_bytes);
+    } else {
+        stats_.avg_frame_bytes += STATS_SMOOTHING * (stats_.frame_bytes - stats_.avg_frame_bytes);
+        stats_.avg_full_frame_bytes +=
+            STATS_SMOOTHING * (stats_.full_frame_bytes - stats_.avg_full_frame_bytes);
+    }
+
+    if (out_.empty()) {
+        // Nothing changed: the terminal already shows this frame
+        if (frame_tag_ != 0) {
+            stats_.written_tag = frame_tag_;
+            stats_.written_at = std::chrono::steady_clock::now();
+        }
+    } else {
+        // Swap rather than copy so both buffers keep their capacity
+        pending_.swap(out_);
+        pending_offset_ = 0;
+        pending_tag_ = frame_tag_;
+        flushPending();
+    }
+    frame_tag_ = 0;
+    stats_.write_time = std::chrono::steady_clock::now() - start;
+}
+
+bool TerminalPresenter::flushPending() {
+    while (pending_offset_ < pending_.size()) {
+        ssize_t n = ::write(fd_, pending_.data() + pending_offset_,
+                            pending_.size() - pending_offset_);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return false;
+            }
+            // Terminal is gone; nothing useful left to do with the bytes
+            encoder_.invalidate();
+            break;
+        }
+        pending_offset_ += static_cast<size_t>(n);
+    }
+    pending_.clear();
+    pending_offset_ = 0;
+    if (pending_tag_ != 0) {
+        stats_.written_tag = pending_tag_;
+        stats_.written_at = std::chrono::steady_clock::now();
+        pending_tag_ = 0;
+    }
+    return true;
+}
+
+void TerminalPresenter::queue(std::string_view bytes) {
+    pending_.append(bytes.data(), bytes.size());
+    flushPending();
+}
+
+void TerminalPresenter::writeAll(const std::string& bytes) {
+    while (!flushPending()) {
+        waitWritable();
+    }
+
+    size_t written = 0;
+    while (written < bytes.size()) {
+        ssize_t n = ::write(fd_, bytes.data() + written, bytes.size() - written);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                waitWritable();
+                continue;
+            }
+            return;
+        }
+        written += static_cast<size_t>(n);
+    }
+}
+
+void TerminalPresenter::waitWritable() {
+    pollfd pfd{fd_, POLLOUT, 0};
+    while (::poll(&pfd, 1, -1) < 0 && errno == EINTR) {
+    }
+}
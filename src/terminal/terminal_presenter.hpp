@@ -0,0 +1,88 @@
+#pragma once
+
+#include "terminal/frame_encoder.hpp"
+#include "terminal/output_stats.hpp"
+
+#include <ftxui/screen/screen.hpp>
+
+#include <cstdint>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+// Owns the bytes that reach the terminal. FTXUI writes its frames through
+// std::cout; the presenter installs itself as std::cout's buffer and, for
+// output produced between beginFrame() and endFrame(), throws FTXUI's full
+// repaint away and writes only the cells that changed since the previous
+// frame (see FrameEncoder). Anything written outside a frame (terminal
+// setup and teardown) passes through untouched and forces the next frame
+// to repaint fully.
+//
+// Frames go out as one non-blocking write wrapped in synchronized-update
+// mode, so a slow terminal never stalls the game loop: while the previous
+// frame is still draining, new frames are dropped and their changes fold
+// into the next diff.
+class TerminalPresenter : private std::streambuf {
+public:
+    explicit TerminalPresenter(ftxui::Screen& screen);
+    ~TerminalPresenter() override;
+
+    TerminalPresenter(const TerminalPresenter&) = delete;
+    TerminalPresenter& operator=(const TerminalPresenter&) = delete;
+
+    // Bracket the calls that may draw a frame (ftxui::Loop::RunOnce)
+    void beginFrame();
+    void endFrame();
+
+    // Label the frame being drawn (a renderer frame id); once its bytes
+    // have all been written, stats().written_tag reports it
+    void tagFrame(uint64_t tag) { frame_tag_ = tag; }
+
+    // Send control bytes in order after any frame still draining. Must not
+    // move the cursor or change the pen.
+    void queue(std::string_view bytes);
+
+    // Forget what is on the terminal; the next frame repaints every cell
+    void invalidate() { encoder_.invalidate(); }
+
+    // A frame is still waiting for the terminal to accept it; call
+    // beginFrame() again later to keep it moving
+    bool draining() const { return !pending_.empty(); }
+
+    const OutputStats& stats() const { return stats_; }
+
+private:
+    // std::streambuf
+    int_type overflow(int_type ch) override;
+    std::streamsize xsputn(const char* s, std::streamsize n) override;
+    int sync() override;
+
+    void presentFrame();
+
+    // Write as much of pending_ as the terminal accepts without blocking;
+    // true once it has fully drained
+    bool flushPending();
+    // Blocking write, after anything still pending (setup/teardown only)
+    void writeAll(const std::string& bytes);
+    void waitWritable();
+
+    ftxui::Screen& screen_;
+    std::streambuf* previous_buf_ = nullptr;
+
+    // Non-blocking descriptor for the terminal. A separate open of the tty
+    // so O_NONBLOCK doesn't leak onto stdin, which shares stdout's file
+    // description
+    int fd_ = -1;
+    bool own_fd_ = false;
+
+    std::string captured_; // Bytes written to std::cout since the last sync
+    std::string out_;      // Encoded frame
+    std::string pending_;  // Frame bytes the terminal hasn't accepted yet
+    size_t pending_offset_ = 0;
+    bool in_frame_ = false;
+    uint64_t frame_tag_ = 0;   // Tag of the frame being drawn
+    uint64_t pending_tag_ = 0; // Tag of the frame in pending_
+
+    FrameEncoder encoder_;
+    OutputStats stats_;
+};
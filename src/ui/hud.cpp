@@ -1,24 +1,38 @@
 #include "ui/hud.hpp"
+#include "diagnostics/memory_tags.hpp"
 
 #include <ftxui/dom/elements.hpp>
 
-#include <sstream>
-#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 
 ftxui::Element HUD::render(int score, float multiplier,
-                           bool debug_enabled, const InputSnapshot& input) {
+                           bool debug_enabled, const InputSnapshot& input,
+                           const OutputStats& output,
+                           const QualityGovernor& quality,
+                           const ParticleStats& particles,
+                           const LatencyTracker& latency,
+                           const Profiler& profiler) {
     using namespace ftxui;
 
+    formatScoreLine(score, multiplier);
     auto hud_line = hbox({
-        text("Score: " + std::to_string(score)) | bold,
+        text(score_text_) | bold,
         filler(),
-        text("x" + formatMultiplier(multiplier)),
+        text(multiplier_text_),
     }) | size(HEIGHT, EQUAL, 1);
 
     if (debug_enabled) {
         return vbox({
             hud_line,
             renderDebugInput(input),
+            renderDebugOutput(output, quality),
+            renderDebugParticles(particles),
+            renderDebugLatency(latency),
+            renderDebugPhysics(profiler),
+            renderDebugMemory(),
+            renderDebugProfile(profiler, quality),
         });
     }
 
@@ -61,8 +75,179 @@ ftxui::Element HUD::renderDebugInput(const InputSnapshot& input) {
     }) | size(HEIGHT, EQUAL, 1);
 }
 
-std::string HUD::formatMultiplier(float mult) {
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(1) << mult;
-    return oss.str();
+ftxui::Element HUD::renderDebugOutput(const OutputStats& output,
+                                      const QualityGovernor& quality) {
+    using namespace ftxui;
+
+    // Bytes actually written vs. what a full repaint of the same frame costs
+    auto frame_bytes = static_cast<long>(output.avg_frame_bytes);
+    auto full_bytes = static_cast<long>(output.avg_full_frame_bytes);
+    int saved = full_bytes > 0
+        ? static_cast<int>(100 - (100 * frame_bytes) / full_bytes)
+        : 0;
+
+    return hbox({
+        filler(),
+        text("Output: ") | dim,
+        text(std::to_string(frame_bytes) + " B/frame"),
+        text("  full: " + std::to_string(full_bytes) + " B/frame") | dim,
+        text("  saved " + std::to_string(saved) + "%"),
+        text("  dropped " + std::to_string(output.frames_dropped)) | dim,
+        text("  " + std::to_string(static_cast<long>(quality.throughput() / 1024)) + " KB/s"),
+        text("  rtt " + std::to_string(static_cast<int>(quality.roundTripMs())) + " ms") | dim,
+        text("  quality: " + std::string(QualityGovernor::levelName(quality.level()))),
+    }) | size(HEIGHT, EQUAL, 1);
+}
+
+ftxui::Element HUD::renderDebugParticles(const ParticleStats& particles) {
+    using namespace ftxui;
+
+    char update[16];
+    std::snprintf(update, sizeof(update), "%.1f us", particles.update_us);
+
+    return hbox({
+        filler(),
+        text("Particles: ") | dim,
+        text(std::to_string(particles.live) + "/" + std::to_string(ParticleSystem::CAPACITY)),
+        text("  update " + std::string(update)),
+        text("  dropped " + std::to_string(particles.dropped)) | dim,
+    }) | size(HEIGHT, EQUAL, 1);
+}
+
+ftxui::Element HUD::renderDebugLatency(const LatencyTracker& latency) {
+    using namespace ftxui;
+
+    auto path = [&](const char* label, InputPath input_path) -> Element {
+        const auto& h = latency.histogram(input_path);
+        char line[64];
+        std::snprintf(line, sizeof(line), "%s p50 %.0f p95 %.0f p99 %.0f ms (n=%llu)", label,
+                      h.percentileMs(50), h.percentileMs(95), h.percentileMs(99),
+                      static_cast<unsigned long long>(h.count()));
+        return h.count() ? text(line) : (text(line) | dim);
+    };
+
+    return hbox({
+        filler(),
+        text("Input->photon: ") | dim,
+        path("kitty", InputPath::Kitty),
+        text("  "),
+        path("fallback", InputPath::Fallback),
+    }) | size(HEIGHT, EQUAL, 1);
+}
+
+ftxui::Element HUD::renderDebugPhysics(const Profiler& profiler) {
+    using namespace ftxui;
+
+    char counts[96];
+    std::snprintf(counts, sizeof(counts),
+                  "bodies %lld  shapes %lld  contacts %lld  joints %lld  islands %lld",
+                  static_cast<long long>(profiler.gauge(ProfileGauge::Bodies).last),
+                  static_cast<long long>(profiler.gauge(ProfileGauge::Shapes).last),
+                  static_cast<long long>(profiler.gauge(ProfileGauge::Contacts).last),
+                  static_cast<long long>(profiler.gauge(ProfileGauge::Joints).last),
+                  static_cast<long long>(profiler.gauge(ProfileGauge::Islands).last));
+
+    return hbox({
+        filler(),
+        text("Box2D: ") | dim,
+        text(counts),
+    }) | size(HEIGHT, EQUAL, 1);
+}
+
+ftxui::Element HUD::renderDebugMemory() {
+    using namespace ftxui;
+
+    auto kib = [](double bytes) { return bytes / 1024.0; };
+
+    Elements rows;
+    for (int i = 0; i < memory::TAG_COUNT; ++i) {
+        const auto tag = static_cast<MemoryTag>(i);
+        const memory::TagStats s = memory::stats(tag);
+        if (s.total_blocks == 0) {
+            continue;
+        }
+        char line[96];
+        int length = std::snprintf(line, sizeof(line), "%-9s %9.1f KiB  peak %9.1f KiB",
+                                   memory::tagName(tag), kib(s.live_bytes), kib(s.peak_bytes));
+        const char* unit = memory::unitName(tag);
+        if (unit && s.units > 0 && length > 0 && length < static_cast<int>(sizeof(line))) {
+            std::snprintf(line + length, sizeof(line) - length, "  %7.2f KiB/%s x%lld",
+                          kib(static_cast<double>(s.live_bytes) / s.units), unit,
+                          static_cast<long long>(s.units));
+        }
+        rows.push_back(hbox({filler(), text(line)}));
+    }
+
+    return vbox({
+        hbox({filler(), text("Memory:") | dim}),
+        vbox(std::move(rows)),
+    });
+}
+
+ftxui::Element HUD::renderDebugProfile(const Profiler& profiler,
+                                       const QualityGovernor& quality) {
+    using namespace ftxui;
+
+    constexpr int BAR_WIDTH = 24;
+    constexpr int SPARK_WIDTH = 64;
+    const double budget_us =
+        std::chrono::duration<double, std::micro>(quality.frameInterval()).count();
+
+    // Solid to p50, shaded on to p99; full width is one frame interval
+    auto bar = [&](double p50_us, double p99_us) {
+        const int solid = std::clamp(static_cast<int>(p50_us / budget_us * BAR_WIDTH), 0, BAR_WIDTH);
+        const int shaded =
+            std::clamp(static_cast<int>(p99_us / budget_us * BAR_WIDTH), solid, BAR_WIDTH);
+        std::string cells;
+        for (int i = 0; i < BAR_WIDTH; ++i) {
+            cells += i < solid ? "\u2588" : i < shaded ? "\u2592" : "\u00b7";
+        }
+        return cells;
+    };
+
+    Elements rows;
+    for (int i = 0; i < Profiler::ZONE_COUNT; ++i) {
+        const auto zone = static_cast<ProfileZone>(i);
+        const Profiler::Recent recent = profiler.recent(zone);
+        if (recent.count == 0) {
+            continue;
+        }
+        char numbers[48];
+        std::snprintf(numbers, sizeof(numbers), " %7.0f %7.0f us", recent.p50_us, recent.p99_us);
+        char name[20];
+        std::snprintf(name, sizeof(name), "%-15s", Profiler::zoneName(zone));
+        rows.push_back(hbox({
+            filler(),
+            text(name) | dim,
+            text(bar(recent.p50_us, recent.p99_us)),
+            text(numbers),
+        }));
+    }
+
+    // Frame times scaled to the slowest in view
+    float history[SPARK_WIDTH];
+    const int count = profiler.history(ProfileZone::Frame, history, SPARK_WIDTH);
+    if (count > 0) {
+        static const char* const LEVELS[] = {"\u2581", "\u2582", "\u2583", "\u2584",
+                                             "\u2585", "\u2586", "\u2587", "\u2588"};
+        const float peak = std::max(*std::max_element(history, history + count), 1.0f);
+        std::string spark;
+        for (int i = 0; i < count; ++i) {
+            spark += LEVELS[std::clamp(static_cast<int>(history[i] / peak * 7.0f + 0.5f), 0, 7)];
+        }
+        char label[32];
+        std::snprintf(label, sizeof(label), " peak %.0f us", peak);
+        rows.push_back(hbox({filler(), text("frame ") | dim, text(spark), text(label)}));
+    }
+
+    return vbox(std::move(rows));
+}
+
+void HUD::formatScoreLine(int score, float multiplier) {
+    // No stream or temporaries; the members keep their capacity
+    char buffer[24];
+    int length = std::snprintf(buffer, sizeof(buffer), "Score: %d", score);
+    score_text_.assign(buffer, std::clamp(length, 0, static_cast<int>(sizeof(buffer)) - 1));
+    length = std::snprintf(buffer, sizeof(buffer), "x%.1f", multiplier);
+    multiplier_text_.assign(buffer, std::clamp(length, 0, static_cast<int>(sizeof(buffer)) - 1));
 }
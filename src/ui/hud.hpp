@@ -1,6 +1,11 @@
 #pragma once
 
+#include "diagnostics/latency_tracker.hpp"
+#include "diagnostics/profiler.hpp"
+#include "game/particle_system.hpp"
 #include "input/input_action.hpp"
+#include "terminal/output_stats.hpp"
+#include "terminal/quality_governor.hpp"
 
 #include <ftxui/dom/elements.hpp>
 
@@ -9,9 +14,28 @@ public:
     HUD() = default;
 
     ftxui::Element render(int score, float multiplier,
-                          bool debug_enabled, const InputSnapshot& input);
+                          bool debug_enabled, const InputSnapshot& input,
+                          const OutputStats& output,
+                          const QualityGovernor& quality,
+                          const ParticleStats& particles,
+                          const LatencyTracker& latency,
+                          const Profiler& profiler);
+
+    // Format the score line into reused buffers (no heap)
+    void formatScoreLine(int score, float multiplier);
 
 private:
-    std::string formatMultiplier(float mult);
+    std::string score_text_;      // "Score: 123"
+    std::string multiplier_text_; // "x1.5"
     ftxui::Element renderDebugInput(const InputSnapshot& input);
+    ftxui::Element renderDebugOutput(const OutputStats& output,
+                                     const QualityGovernor& quality);
+    ftxui::Element renderDebugParticles(const ParticleStats& particles);
+    ftxui::Element renderDebugLatency(const LatencyTracker& latency);
+    ftxui::Element renderDebugPhysics(const Profiler& profiler);
+    // Live and peak heap bytes per subsystem, with per-line/segment cost
+    ftxui::Element renderDebugMemory();
+    // p50/p99 bar per zone against the frame budget, plus a frame-time sparkline
+    ftxui::Element renderDebugProfile(const Profiler& profiler,
+                                      const QualityGovernor& quality);
 };
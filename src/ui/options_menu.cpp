@@ -3,18 +3,40 @@
 #include <ftxui/component/component.hpp>
 #include <ftxui/dom/elements.hpp>
 
-OptionsMenu::OptionsMenu(std::function<void(GameState)> on_transition, bool* debug_enabled)
+OptionsMenu::OptionsMenu(std::function<void(GameState)> on_transition, bool* debug_enabled,
+                         CellEncoding* cell_encoding, TerrainFill* terrain_fill,
+                         bool* background_enabled)
     : on_transition_(std::move(on_transition)),
       debug_enabled_(debug_enabled),
-      entries_({"Debug: Off", "Option 2", "Option 3", "Back"}) {
+      cell_encoding_(cell_encoding),
+      terrain_fill_(terrain_fill),
+      background_enabled_(background_enabled),
+      entries_({"Debug: Off", "", "", "", "Back"}) {
+
+    auto cells_label = [this] {
+        return std::string("Cells: ") + CellEncoder::name(*cell_encoding_);
+    };
+    auto terrain_label = [this] {
+        return std::string("Terrain: ") + TerrainRenderer::fillName(*terrain_fill_);
+    };
+    entries_[1] = cells_label();
+    entries_[2] = terrain_label();
+    entries_[3] = *background_enabled_ ? "Background: On" : "Background: Off";
 
     using namespace ftxui;
 
     auto option = MenuOption::Vertical();
-    option.on_enter = [this] {
+    option.on_enter = [this, cells_label, terrain_label] {
         if (selected_ == 0) {
             *debug_enabled_ = !(*debug_enabled_);
             entries_[0] = *debug_enabled_ ? "Debug: On" : "Debug: Off";
+        } else if (selected_ == 1) {
+            *cell_encoding_ = CellEncoder::next(*cell_encoding_);
+            entries_[1] = cells_label();
+        } else if (selected_ == 2) {
+            *terrain_fill_ = TerrainRenderer::nextFill(*terrain_fill_);
+            entries_[2] = terrain_label();
+    entries_[3] = *background_enabled_ ? "Background: On" : "Background: Off";
         } else if (selected_ == static_cast<int>(entries_.size()) - 1) {
             on_transition_(GameState::StartMenu);
         }
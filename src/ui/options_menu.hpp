@@ -1,6 +1,8 @@
 #pragma once
 
 #include "game_state.hpp"
+#include "rendering/cell_encoder.hpp"
+#include "rendering/terrain_renderer.hpp"
 
 #include <ftxui/component/component.hpp>
 
@@ -8,13 +10,18 @@
 
 class OptionsMenu {
 public:
-    explicit OptionsMenu(std::function<void(GameState)> on_transition, bool* debug_enabled);
+    OptionsMenu(std::function<void(GameState)> on_transition, bool* debug_enabled,
+                CellEncoding* cell_encoding, TerrainFill* terrain_fill,
+                bool* background_enabled);
 
     ftxui::Component component();
 
 private:
     std::function<void(GameState)> on_transition_;
     bool* debug_enabled_;
+    CellEncoding* cell_encoding_;
+    TerrainFill* terrain_fill_;
+    bool* background_enabled_;
     std::vector<std::string> entries_;
     int selected_ = 0;
     ftxui::Component menu_component_;
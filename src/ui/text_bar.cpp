@@ -2,77 +2,71 @@
 
 #include <ftxui/dom/elements.hpp>
 
-#include <cmath>
-#include <sstream>
+#include <algorithm>
 
 ftxui::Element TextBar::render(const std::vector<LevelSegment>& segments,
                                 float viewport_left,
                                 float viewport_right,
-                                int screen_width_chars,
-                                int screen_width_braille_pixels) {
+                                int screen_width_chars) {
     using namespace ftxui;
+    return text(layout(segments, viewport_left, viewport_right, screen_width_chars)) | border;
+}
 
+const std::string& TextBar::layout(const std::vector<LevelSegment>& segments,
+                                   float viewport_left,
+                                   float viewport_right,
+                                   int screen_width_chars) {
     // Available width inside the border (left + right border chars)
     int text_width = screen_width_chars - 2;
     if (text_width <= 0) {
-        return border(text(""));
+        buffer_.clear();
+        return buffer_;
     }
 
-    // Each display character occupies 0.15 world units (matches level_generator.cpp)
-    constexpr float chars_to_world = 0.15f;
-    constexpr float pixels_per_meter = 30.0f;
+    constexpr float chars_to_world = LevelSegment::CHAR_WORLD_WIDTH;
 
     // Viewport width in world units
-    float viewport_width_world = screen_width_braille_pixels / pixels_per_meter;
+    float viewport_width_world = viewport_right - viewport_left;
 
-    // Build a buffer of spaces, then place words from visible segments
-    std::string buffer(text_width, ' ');
+    // Place words from visible segments into a reused row of spaces
+    buffer_.assign(text_width, ' ');
 
-    for (const auto& segment : segments) {
-        // Quick cull: skip segments entirely outside viewport
-        if (segment.end_x < viewport_left || segment.start_x > viewport_right) {
-            continue;
-        }
+    // Segments are laid out left to right. The cursor follows the view
+    // forward; a restart or a jump back re-finds it by binary search.
+    if (first_segment_ >= segments.size() ||
+        (first_segment_ > 0 && segments[first_segment_ - 1].end_x >= viewport_left)) {
+        first_segment_ = std::partition_point(segments.begin(), segments.end(),
+            [&](const LevelSegment& s) { return s.end_x < viewport_left; }) - segments.begin();
+    }
+    while (first_segment_ < segments.size() && segments[first_segment_].end_x < viewport_left) {
+        ++first_segment_;
+    }
 
-        if (segment.display_text.empty()) {
-            continue;
+    for (size_t s = first_segment_; s < segments.size(); ++s) {
+        const LevelSegment& segment = segments[s];
+        if (segment.start_x > viewport_right) {
+            break;
         }
 
-        // Parse display_text into words and their positions
-        std::istringstream iss(segment.display_text);
-        std::string word;
-        size_t char_index = 0;
-
-        while (iss >> word) {
-            // Find the position of this word in display_text
-            size_t word_start = segment.display_text.find(word, char_index);
-            if (word_start == std::string::npos) {
-                break;
-            }
-            char_index = word_start + word.length();
-
-            // World position of the first character of this word
-            float word_world_x = segment.start_x + word_start * chars_to_world;
-
-            // Check if word is within viewport
-            float word_end_world_x = word_world_x + word.length() * chars_to_world;
-            if (word_end_world_x < viewport_left || word_world_x > viewport_right) {
-                continue;
-            }
+        // First word that ends inside the viewport
+        auto word = std::partition_point(segment.words.begin(), segment.words.end(),
+            [&](const LevelSegment::Word& w) {
+                return w.world_x + w.length * chars_to_world < viewport_left;
+            });
 
+        for (; word != segment.words.end() && word->world_x <= viewport_right; ++word) {
             // Map word's world position to screen column
-            float normalized = (word_world_x - viewport_left) / viewport_width_world;
+            float normalized = (word->world_x - viewport_left) / viewport_width_world;
             int start_col = static_cast<int>(normalized * text_width);
 
-            // Draw each character of the word consecutively
-            for (size_t i = 0; i < word.length(); ++i) {
-                int col = start_col + static_cast<int>(i);
-                if (col >= 0 && col < text_width) {
-                    buffer[col] = word[i];
-                }
+            // Copy the part of the word that lands on screen
+            int first = std::max(0, -start_col);
+            int last = std::min(static_cast<int>(word->length), text_width - start_col);
+            for (int i = first; i < last; ++i) {
+                buffer_[start_col + i] = segment.display_text[word->offset + i];
             }
         }
     }
 
-    return text(buffer) | border;
+    return buffer_;
 }
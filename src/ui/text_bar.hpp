@@ -4,6 +4,8 @@
 
 #include <ftxui/dom/elements.hpp>
 
+#include <cstddef>
+#include <string>
 #include <vector>
 
 class TextBar {
@@ -13,6 +15,16 @@ public:
     ftxui::Element render(const std::vector<LevelSegment>& segments,
                           float viewport_left,
                           float viewport_right,
-                          int screen_width_chars,
-                          int screen_width_braille_pixels);
+                          int screen_width_chars);
+
+    // Compose the row render() shows (no heap once the row has grown to
+    // the screen width); empty if the screen is too narrow
+    const std::string& layout(const std::vector<LevelSegment>& segments,
+                              float viewport_left,
+                              float viewport_right,
+                              int screen_width_chars);
+
+private:
+    std::string buffer_;       // Row being composed, kept between frames
+    size_t first_segment_ = 0; // First segment reaching the viewport last frame
 };